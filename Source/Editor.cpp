@@ -1,5 +1,8 @@
 #include "Editor.h"
 
+// draws the most expensive timer callbacks over the center panel
+#define ShowCallbackCosts false
+
 namespace gui
 {
     evt::Evt makeEvt(Editor& editor)
@@ -43,8 +46,12 @@ namespace gui
             envGenMod.setVisible(val == 0);
 			envFolMod.setVisible(val == 1);
 			randMod.setVisible(val == 2);
+#if JUCE_DEBUG && ShowCallbackCosts
+            repaint(layout(1, 2, 1, 1).toNearestInt());
+#endif
         }, 0, cbFPS::k15, true)),
-        marbleImg(juce::ImageCache::getFromMemory(BinaryData::marble_png, BinaryData::marble_pngSize)),
+        marbleImg(),
+        marbleRequest(std::make_shared<std::atomic<int>>(0)),
         utils(*this, p),
         layout(),
         evtMember(utils.eventSystem, makeEvt(*this)),
@@ -81,13 +88,13 @@ namespace gui
         ),
 		envFolMod
         (
-            p.pluginProcessor.envFolMod, utils,
+            utils,
             PID::EnvFolModGain, PID::EnvFolModAttack,
             PID::EnvFolModDecay, PID::EnvFolModSmooth
         ),
         randMod
         (
-			p.pluginProcessor.randMod, utils,
+			utils,
 			PID::RandModRateSync,
 			PID::RandModSmooth,
 			PID::RandModComplex,
@@ -135,6 +142,7 @@ namespace gui
 
         {
             modSelect.attach(PID::ModSelect);
+            callback.name = "Editor";
             utils.add(&callback);
         }
 
@@ -243,14 +251,21 @@ namespace gui
     
     void Editor::paint(Graphics& g)
     {
+        if (!marbleImg.isValid())
+            g.fillAll(Colours::c(CID::Bg));
         g.drawImageAt(marbleImg, 0, 0, false);
         g.setColour(Colours::c(CID::Bg).withMultipliedAlpha(.85f));
         g.fillAll();
     }
 
-    void Editor::paintOverChildren(Graphics&)
+    void Editor::paintOverChildren(Graphics& g)
     {
         //layout.paint(g, Colour(0x11ffffff));
+#if JUCE_DEBUG && ShowCallbackCosts
+        utils.callbacks.paintStats(g, layout(1, 2, 1, 1));
+#else
+        juce::ignoreUnused(g);
+#endif
     }
 
     bool needsResize(Editor& e)
@@ -307,20 +322,50 @@ namespace gui
         e.modSelect.setBounds(BoundsF(x, y, w, e.layout.getY(4.f) - y).toNearestInt());
     }
 
+    // width, height
+    Image makeMarbleImage(int width, int height)
+    {
+        auto img = juce::ImageCache::getFromMemory(BinaryData::marble_png, BinaryData::marble_pngSize);
+        fixStupidJUCEImageThingie(img);
+        img = img.rescaled(width, height);
+        juce::Image::BitmapData bitmap(img, juce::Image::BitmapData::readWrite);
+        for (auto y = 0; y < bitmap.height; ++y)
+            for (auto x = 0; x < bitmap.width; ++x)
+            {
+                const auto pxl = bitmap.getPixelColour(x, y);
+                bitmap.setPixelColour(x, y, pxl.withBrightness(1.f - pxl.getBrightness()));
+            }
+        return img;
+    }
+
+    // scaling and inverting the marble takes longer than a frame, so it happens on the render worker
+    void updateMarbleImage(Editor& e)
+    {
+        const auto r = e.marbleRequest->fetch_add(1) + 1;
+        const auto width = e.getWidth();
+        const auto height = e.getHeight();
+        RenderWorker::launch([width, height, r, req = e.marbleRequest, safe = Component::SafePointer<Editor>(&e)]()
+        {
+            if (req->load() != r)
+                return;
+            const auto img = makeMarbleImage(width, height);
+            juce::MessageManager::callAsync([img, r, req, safe]()
+            {
+                if (safe == nullptr || req->load() != r)
+                    return;
+                safe->marbleImg = img;
+                safe->repaint();
+            });
+        });
+    }
+
     void Editor::resized()
     {
         if (needsResize(*this))
             return;
         saveBounds(*this);
 
-        marbleImg = juce::ImageCache::getFromMemory(BinaryData::marble_png, BinaryData::marble_pngSize).rescaled(getWidth(), getHeight());
-		fixStupidJUCEImageThingie(marbleImg);
-        for (auto y = 0; y < marbleImg.getHeight(); ++y)
-            for (auto x = 0; x < marbleImg.getWidth(); ++x)
-            {
-				auto pxl = marbleImg.getPixelAt(x, y);
-                marbleImg.setPixelAt(x, y, pxl.withBrightness(1.f - pxl.getBrightness()));
-            }
+        updateMarbleImage(*this);
 
         compPower.setBounds(getLocalBounds());
 
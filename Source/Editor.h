@@ -34,6 +34,7 @@ namespace gui
         Processor& audioProcessor;
         Callback callback;
         Image marbleImg;
+        std::shared_ptr<std::atomic<int>> marbleRequest;
         Utils utils;
         Layout layout;
         evt::Member evtMember;
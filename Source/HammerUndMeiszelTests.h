@@ -154,24 +154,60 @@ namespace test
 		bool keepExistingMIDI;
 	};
 
-	struct SpeedTestPB
+	struct SpeedTest
 	{
-		using PBFunc = std::function<void(double**, juce::MidiBuffer&, int, int)>;
+		SpeedTest() :
+			startTime(std::chrono::high_resolution_clock::now())
+		{}
 
-		struct SpeedTest
+		std::chrono::nanoseconds getElapsed()
 		{
-			SpeedTest() :
-				startTime(std::chrono::high_resolution_clock::now())
-			{}
+			const auto endTime = std::chrono::high_resolution_clock::now();
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime);
+		}
 
-			std::chrono::nanoseconds getElapsed()
-			{
-				const auto endTime = std::chrono::high_resolution_clock::now();
-				return std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime);
-			}
+		std::chrono::high_resolution_clock::time_point startTime;
+	};
 
-			std::chrono::high_resolution_clock::time_point startTime;
-		};
+	// writes average, median, worst case and all times to Desktop/SpeedTests
+	inline void writeSpeedTest(const std::vector<std::chrono::nanoseconds>& times, const juce::String& fileName)
+	{
+		auto average = times[0];
+		for (auto i = 1; i < times.size(); ++i)
+			average += times[i];
+		average /= times.size();
+
+		auto max = times[0];
+		for (auto i = 1; i < times.size(); ++i)
+			if (times[i] > max)
+				max = times[i];
+
+		auto sortedTimes = times;
+		std::sort(sortedTimes.begin(), sortedTimes.end());
+		auto median = sortedTimes[sortedTimes.size() / 2];
+
+		auto desktop = juce::File::getSpecialLocation(juce::File::SpecialLocationType::userDesktopDirectory);
+		auto folder = desktop.getChildFile("SpeedTests");
+		if (!folder.exists())
+			folder.createDirectory();
+		auto fileNameFull = juce::String(__DATE__) + juce::String(__TIME__) + " " + fileName + ".txt";
+		fileNameFull = juce::File::createLegalFileName(fileNameFull);
+		auto file = folder.getChildFile(fileNameFull);
+		if (file.existsAsFile())
+			file.deleteFile();
+		file.create();
+
+		file.appendText("Iterations: " + juce::String(static_cast<int>(times.size())) + "\n");
+		file.appendText("Average: " + juce::String(average.count() / 1000000.) + "ms\n");
+		file.appendText("Median: " + juce::String(median.count() / 1000000.) + "ms\n");
+		file.appendText("Worse Case: " + juce::String(max.count() / 1000000.) + "ms\n");
+		for (auto& time : times)
+			file.appendText(juce::String(time.count() / 1000000.) + "ms\n");
+	}
+
+	struct SpeedTestPB
+	{
+		using PBFunc = std::function<void(double**, juce::MidiBuffer&, int, int)>;
 
 		SpeedTestPB(PBFunc&& pbFunc, int iterations, juce::String&& fileName) :
 			buffer(2, dsp::BlockSize2x),
@@ -194,41 +230,34 @@ namespace test
 				times.push_back(test.getElapsed());
 			}
 
-			auto average = times[0];
-			for (auto i = 1; i < times.size(); ++i)
-				average += times[i];
-			average /= times.size();
-
-			auto max = times[0];
-			for (auto i = 1; i < times.size(); ++i)
-				if (times[i] > max)
-					max = times[i];
-
-			auto sortedTimes = times;
-			std::sort(sortedTimes.begin(), sortedTimes.end());
-			auto median = sortedTimes[sortedTimes.size() / 2];
-
-			auto desktop = juce::File::getSpecialLocation(juce::File::SpecialLocationType::userDesktopDirectory);
-			auto folder = desktop.getChildFile("SpeedTests");
-			if (!folder.exists())
-				folder.createDirectory();
-			auto fileNameFull = juce::String(__DATE__) + juce::String(__TIME__) + " " + fileName + ".txt";
-			fileNameFull = juce::File::createLegalFileName(fileNameFull);
-			auto file = folder.getChildFile(fileNameFull);
-			if (file.existsAsFile())
-				file.deleteFile();
-			file.create();
-
-			file.appendText("Iterations: " + juce::String(iterations) + "\n");
-			file.appendText("Average: " + juce::String(average.count() / 1000000.) + "ms\n");
-			file.appendText("Median: " + juce::String(median.count() / 1000000.) + "ms\n");
-			file.appendText("Worse Case: " + juce::String(max.count() / 1000000.) + "ms\n");
-			for (auto& time : times)
-				file.appendText(juce::String(time.count() / 1000000.) + "ms\n");
+			writeSpeedTest(times, fileName);
 		}
 
 		dsp::AudioBuffer buffer;
 		dsp::MidiBuffer midi;
 		juce::Random rand;
 	};
+
+	// opens, lays out, paints and closes the editor, to measure how long it takes until it shows up
+	struct SpeedTestEditor
+	{
+		using EditorFunc = std::function<juce::Component*()>;
+
+		SpeedTestEditor(EditorFunc&& makeEditor, int iterations, juce::String&& fileName)
+		{
+			std::vector<std::chrono::nanoseconds> times;
+
+			for (auto i = 0; i < iterations; ++i)
+			{
+				SpeedTest test;
+				{
+					std::unique_ptr<juce::Component> editor(makeEditor());
+					editor->createComponentSnapshot(editor->getLocalBounds());
+				}
+				times.push_back(test.getElapsed());
+			}
+
+			writeSpeedTest(times, fileName);
+		}
+	};
 }
\ No newline at end of file
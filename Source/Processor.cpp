@@ -7,8 +7,11 @@
 
 #include "arch/Math.h"
 #include "audio/dsp/Distortion.h"
+#include "audio/dsp/Shaper.h"
 
 #define KeepState true
+// writes the editor's opening times to Desktop/SpeedTests
+#define SpeedTestEditorOpen false
 
 namespace audio
 {
@@ -31,6 +34,7 @@ namespace audio
     Processor::Processor() :
         juce::AudioProcessor(makeBusesProps()),
 		Timer(),
+        juce::AsyncUpdater(),
 #if PPDHasTuningEditor
 		xenManager(),
         params(*this, xenManager),
@@ -38,13 +42,24 @@ namespace audio
 		params(*this),
 #endif
         state(),
+        stateLayout(params.getLayout()),
+        stateLayoutHash(static_cast<uint32_t>(stateLayout.hashCode())),
+        stateFloats(params.numFloats() + PluginProcessor::NumFloats, 0.f),
         
         transport(),
+        sharedState(),
         pluginProcessor(params
 #if PPDHasTuningEditor
 		, xenManager
 #endif
-        ),
+        , sharedState),
+        pluginProcessorAlt(params
+#if PPDHasTuningEditor
+		, xenManager
+#endif
+        , sharedState),
+        engine(&pluginProcessor),
+        engineOut(&pluginProcessorAlt),
         audioBufferD(),
         midiSubBuffer(),
         midiOutBuffer(),
@@ -56,59 +71,131 @@ namespace audio
         oversampler(),
 #endif
         sampleRateUp(0.),
-        blockSizeUp(dsp::BlockSize)
+        blockSizeUp(dsp::BlockSize),
+        idleSamples(0),
+        idleSamplesMax(0),
+        patchXFade(),
+        patchMutex(),
+        patchPending(),
+        statePending(),
+        patchStage(PatchStage::Idle),
+        lastBlockMs(0),
+        telemetry(),
+        telemetryRecord(),
+        sleepReported(false),
+        factoryInstaller(),
+        initPatch()
+    {
+        dsp::shaper::init();
+        makeInitPatch();
+        installFactoryPatches();
+
+        for (auto& highpass : highpasses)
+            highpass.setType(juce::dsp::FirstOrderTPTFilterType::highpass);
+
+#if PPDHasTuningEditor
+        // both engines retune, so that the one taking over at a patch change is in tune already
+        xenManager.updateFunc = [&](const XenManager::Info&, int numChannels)
+        {
+            pluginProcessor.triggerXen(numChannels);
+            pluginProcessorAlt.triggerXen(numChannels);
+        };
+#endif
+    }
+
+    void Processor::makeInitPatch()
     {
+        State init;
+        init.set("author", "factory");
+        params.savePatch(init);
+        pluginProcessor.savePatch(init);
+        initPatch = init.state;
+    }
+
+    const Processor::ValueTree& Processor::getInitPatch() const noexcept
+    {
+        return initPatch;
+    }
+
+    void Processor::installFactoryPatches()
+    {
+        // only the first instance of a session checks, all others skip the disk entirely
+        static std::atomic<bool> checked(false);
+        if (checked.exchange(true))
+            return;
+
+        using File = juce::File;
+        using String = juce::String;
         const auto& user = *state.props.getUserSettings();
         const auto& settingsFile = user.getFile();
         const auto settingsDirectory = settingsFile.getParentDirectory();
-		const auto patchesDirectory = settingsDirectory.getChildFile("Patches");
-        if (!patchesDirectory.exists())
-        {
-            patchesDirectory.createDirectory();
+        const auto patchesDirectory = settingsDirectory.getChildFile("Patches");
+        // the version, then the names of all factory patches ever installed, one per line
+        const auto stampFile = patchesDirectory.getChildFile(".factory");
+        const String version(JucePlugin_VersionString);
+        juce::StringArray stamp;
+        stampFile.readLines(stamp);
+        if (!stamp.isEmpty() && stamp[0] == version)
+            return;
 
-			using String = juce::String;
-            const auto makePatch = [&p = patchesDirectory](const String& name, const void* data, int size)
+        factoryInstaller = std::thread([patchesDirectory, stampFile, version, stamp]()
+        {
+            struct FactoryPatch
+            {
+                const char* name;
+                const void* data;
+                int size;
+            };
+            const FactoryPatch factoryPatches[] =
             {
-                const auto initFile = p.getChildFile(name + ".txt");
-                if (initFile.existsAsFile())
-                    initFile.deleteFile();
-                initFile.create();
-                initFile.replaceWithData(data, size);
+                { "Dematerialisiere", BinaryData::Dematerialisiere_txt, BinaryData::Dematerialisiere_txtSize },
+                { "Doktor Tropfsteinhoele", BinaryData::Doktor_Tropfsteinhoele_txt, BinaryData::Doktor_Tropfsteinhoele_txtSize },
+                { "Zerbrochen", BinaryData::Zerbrochen_txt, BinaryData::Zerbrochen_txtSize },
+                { "Tingeling", BinaryData::Tingeling_txt, BinaryData::Tingeling_txtSize },
+                { "Slickmap", BinaryData::Slickmap_txt, BinaryData::Slickmap_txtSize },
+                { "Black Hole", BinaryData::Black_Hole_txt, BinaryData::Black_Hole_txtSize },
+                { "Dark Morning", BinaryData::Dark_Morning_txt, BinaryData::Dark_Morning_txtSize },
+                { "Ensamble", BinaryData::Ensamble_txt, BinaryData::Ensamble_txtSize },
+                { "Fake Reverb", BinaryData::Fake_Reverb_txt, BinaryData::Fake_Reverb_txtSize },
+                { "Hat Sweetener", BinaryData::Hat_Sweetener_txt, BinaryData::Hat_Sweetener_txtSize },
+                { "Percussive Particles", BinaryData::Percussive_Particles_txt, BinaryData::Percussive_Particles_txtSize },
+                { "Robo Madness", BinaryData::Robo_Madness_txt, BinaryData::Robo_Madness_txtSize },
+                { "Shooting Star", BinaryData::Shooting_Star_txt, BinaryData::Shooting_Star_txtSize },
+                { "Sweet Night", BinaryData::Sweet_Night_txt, BinaryData::Sweet_Night_txtSize },
+                { "Unstable Identity", BinaryData::Unstable_Identity_txt, BinaryData::Unstable_Identity_txtSize },
+                { "Orgelklang", BinaryData::Orgelklang_txt, BinaryData::Orgelklang_txtSize }
             };
-            makePatch("Dematerialisiere", BinaryData::Dematerialisiere_txt, BinaryData::Dematerialisiere_txtSize);
-			makePatch("Doktor Tropfsteinhoele", BinaryData::Doktor_Tropfsteinhoele_txt, BinaryData::Doktor_Tropfsteinhoele_txtSize);
-			makePatch("Zerbrochen", BinaryData::Zerbrochen_txt, BinaryData::Zerbrochen_txtSize);
-            makePatch("Tingeling", BinaryData::Tingeling_txt, BinaryData::Tingeling_txtSize);
-			makePatch("Slickmap", BinaryData::Slickmap_txt, BinaryData::Slickmap_txtSize);
-			makePatch("Black Hole", BinaryData::Black_Hole_txt, BinaryData::Black_Hole_txtSize);
-			makePatch("Dark Morning", BinaryData::Dark_Morning_txt, BinaryData::Dark_Morning_txtSize);
-			makePatch("Ensamble", BinaryData::Ensamble_txt, BinaryData::Ensamble_txtSize);
-			makePatch("Fake Reverb", BinaryData::Fake_Reverb_txt, BinaryData::Fake_Reverb_txtSize);
-			makePatch("Hat Sweetener", BinaryData::Hat_Sweetener_txt, BinaryData::Hat_Sweetener_txtSize);
-			makePatch("Percussive Particles", BinaryData::Percussive_Particles_txt, BinaryData::Percussive_Particles_txtSize);
-			makePatch("Robo Madness", BinaryData::Robo_Madness_txt, BinaryData::Robo_Madness_txtSize);
-			makePatch("Shooting Star", BinaryData::Shooting_Star_txt, BinaryData::Shooting_Star_txtSize);
-			makePatch("Sweet Night", BinaryData::Sweet_Night_txt, BinaryData::Sweet_Night_txtSize);
-			makePatch("Unstable Identity", BinaryData::Unstable_Identity_txt, BinaryData::Unstable_Identity_txtSize);
-			makePatch("Orgelklang", BinaryData::Orgelklang_txt, BinaryData::Orgelklang_txtSize);
-		}
-
-        state.set("author", "factory");
-        params.savePatch(state);
-        pluginProcessor.savePatch(state);
-        const auto init = state.state.createCopy();
-        const auto initFile = patchesDirectory.getChildFile(" init .txt");
-        if (initFile.existsAsFile())
-            initFile.deleteFile();
-        initFile.create();
-		initFile.replaceWithText(init.toXmlString());
 
-        for (auto& highpass : highpasses)
-            highpass.setType(juce::dsp::FirstOrderTPTFilterType::highpass);
+            // versions before the list installed all of these whenever the folder was missing
+            const bool legacy = stamp.size() < 2 && patchesDirectory.exists();
+            if (!patchesDirectory.exists())
+                patchesDirectory.createDirectory();
+
+            juce::StringArray nStamp(version);
+            for (const auto& patch : factoryPatches)
+            {
+                nStamp.add(patch.name);
+                if (legacy || stamp.contains(patch.name))
+                    continue;
+                const auto file = patchesDirectory.getChildFile(String(patch.name) + ".txt");
+                if (!file.existsAsFile())
+                    file.replaceWithData(patch.data, patch.size);
+            }
+
+            // the init patch is served from memory now
+            const auto initFile = patchesDirectory.getChildFile(" init .txt");
+            if (initFile.existsAsFile())
+                initFile.deleteFile();
+
+            // stamped last, so that an interrupted install is repeated
+            stampFile.replaceWithText(nStamp.joinIntoString("\n"));
+        });
     }
 
     Processor::~Processor()
     {
+        if (factoryInstaller.joinable())
+            factoryInstaller.join();
         auto& user = *state.props.getUserSettings();
         user.setValue("firstTimeUwU", false);
         user.save();
@@ -205,6 +292,7 @@ namespace audio
 #endif
         transport.prepare(1. / sampleRate);
         pluginProcessor.prepare(sampleRateUp);
+        pluginProcessorAlt.prepare(sampleRateUp);
         juce::dsp::ProcessSpec spec;
 		spec.sampleRate = sampleRateUp;
 		spec.maximumBlockSize = blockSizeUp;
@@ -216,6 +304,13 @@ namespace audio
             highpass.setCutoffFrequency(20.f);
         }
         recorder.prepare(sampleRate);
+        telemetry.prepare(sampleRate);
+        // long enough for the latency and the filters' tails to fade out
+        static constexpr double IdleMs = 500.;
+        idleSamplesMax = static_cast<int>(math::msToSamples(IdleMs, sampleRate));
+        idleSamples = 0;
+        const auto patchFadeMs = state.props.getUserSettings()->getDoubleValue("patchFadeMs", PatchFadeMs);
+        patchXFade.prepare(sampleRateUp, patchFadeMs, blockSizeUp);
         setLatencySamples(latency);
         startTimerHz(4);
     }
@@ -262,21 +357,79 @@ namespace audio
 
     juce::AudioProcessorEditor* Processor::createEditor()
     {
+#if JUCE_DEBUG && SpeedTestEditorOpen
+        test::SpeedTestEditor([&]()
+        {
+            return new gui::Editor(*this);
+        }, 16, "Editor Open");
+#endif
         return new gui::Editor(*this);
     }
 
     void Processor::getStateInformation(juce::MemoryBlock& destData)
     {
 #if KeepState
-        pluginProcessor.savePatch(state);
-        params.savePatch(state);
-        state.savePatch(*this, destData);
+        {
+            const std::lock_guard<std::mutex> lock(patchMutex);
+            if (statePending.getSize() != 0)
+            {
+                destData = statePending;
+                return;
+            }
+        }
+        // setStateInformation reads states of any size into it
+        stateFloats.resize(params.numFloats() + PluginProcessor::NumFloats);
+        auto floats = stateFloats.data();
+        params.savePatch(floats);
+        pluginProcessor.savePatch(state, &floats[params.numFloats()]);
+        state.savePatch(destData, stateLayoutHash, stateFloats, stateLayout);
 #endif
     }
 
     void Processor::setStateInformation(const void* data, int sizeInBytes)
     {
 #if KeepState
+        const juce::MemoryBlock block(data, static_cast<size_t>(sizeInBytes));
+        loadPatchStaged([this, block]()
+        {
+            applyStateInformation(block.getData(), static_cast<int>(block.getSize()));
+        });
+        const std::lock_guard<std::mutex> lock(patchMutex);
+        if (patchPending != nullptr)
+            statePending = block;
+#endif
+    }
+
+    void Processor::applyStateInformation(const void* data, int sizeInBytes)
+    {
+#if KeepState
+        uint32_t layout = 0;
+        juce::String layoutIds;
+        if (state.loadPatch(data, sizeInBytes, layout, stateFloats, layoutIds))
+        {
+            const auto floats = stateFloats.data();
+            const auto numFloatsParams = params.numFloats();
+            const auto numFloats = numFloatsParams + PluginProcessor::NumFloats;
+            if (layout == stateLayoutHash && stateFloats.size() == numFloats)
+            {
+                params.loadPatch(floats);
+                pluginProcessor.loadPatch(state, &floats[numFloatsParams]);
+            }
+            else
+            {
+                // saved by a version with different parameters, so bind them by id
+                juce::StringArray ids;
+                ids.addTokens(layoutIds, ",", "");
+                const auto numFloatsSaved = 1 + static_cast<size_t>(ids.size()) * Params::NumFloatsPerParam;
+                if (numFloatsSaved > stateFloats.size())
+                    return;
+                params.loadPatch(floats, ids);
+                if (stateFloats.size() == numFloatsSaved + PluginProcessor::NumFloats)
+                    pluginProcessor.loadPatch(state, &floats[numFloatsSaved]);
+            }
+            return;
+        }
+        // xml state of earlier versions
         state.loadPatch(*this, data, sizeInBytes);
         params.loadPatch(state);
         pluginProcessor.loadPatch(state);
@@ -303,7 +456,7 @@ namespace audio
             const auto dif = numSamplesMain - s;
             const auto numSamples = dif < dsp::BlockSize ? dif : dsp::BlockSize;
 
-            pluginProcessor.processBlockBypassed(samples, midiMessages, numChannels, numSamples);
+            engine->processBlockBypassed(samples, midiMessages, numChannels, numSamples);
         }
     }
 
@@ -345,9 +498,6 @@ namespace audio
             return processBlockBypassed(buffer, midiMessages);
 		
         juce::ScopedNoDenormals noDenormals;
-		
-        const auto macroVal = params(PID::Macro).getValue();
-        params.modulate(macroVal);
 
         const auto numSamplesMain = buffer.getNumSamples();
         {
@@ -358,6 +508,14 @@ namespace audio
         }
         if (numSamplesMain == 0)
             return;
+        lastBlockMs.store(juce::Time::getMillisecondCounter());
+        if (sleep(buffer, midiMessages))
+            return;
+        const auto startTicks = juce::Time::getHighResolutionTicks();
+
+        const auto macroVal = params(PID::Macro).getValue();
+        params.modulate(macroVal);
+        stagePatch();
 		
         const auto numChannels = buffer.getNumChannels();
 		auto samplesMain = buffer.getArrayOfWritePointers();
@@ -512,19 +670,23 @@ namespace audio
 
 		const auto& softClipParam = params(PID::SoftClip);
 		const auto softClip = softClipParam.getValMod() > .5f;
-        const auto knee = .5 / dsp::Pi;
         if(softClip)
-        {
 			for (auto ch = 0; ch < numChannels; ++ch)
-			{
-				auto smpls = samplesMain[ch];
-                for (auto s = 0; s < numSamplesMain; ++s)
-                    smpls[s] = dsp::softclipPrismaHeavy(smpls[s], 1., knee);
-			}
-		}
+				dsp::shaper::softclip(samplesMain[ch], numSamplesMain, dsp::ShaperAccuracy::High);
 
         recorder(samplesMain, numChannels, numSamplesMain);
 
+        if (sharedState.editorExists.load())
+        {
+            engine->report(telemetryRecord);
+            const auto ticks = juce::Time::getHighResolutionTicks() - startTicks;
+            const auto secs = juce::Time::highResolutionTicksToSeconds(ticks);
+            telemetryRecord.cpu = static_cast<float>(secs * getSampleRate() / static_cast<double>(numSamplesMain));
+            telemetryRecord.scopeRate = telemetry.getScopeRate();
+            telemetry.push(telemetryRecord);
+            telemetry.pushScope(samplesMain, numChannels, numSamplesMain);
+        }
+
 #if JUCE_DEBUG && false
         for (auto ch = 0; ch < numChannels; ++ch)
         {
@@ -535,6 +697,117 @@ namespace audio
 #endif
     }
 
+    bool Processor::sleep(AudioBufferD& buffer, const MidiBuffer& midiMessages) noexcept
+    {
+        const auto numChannels = buffer.getNumChannels();
+        const auto numSamples = buffer.getNumSamples();
+        auto samples = buffer.getArrayOfWritePointers();
+
+        // squared, about -120 dBFS. the dry path passes quiet input that must not be cut off
+        static constexpr double SilenceEps = 1e-12;
+        const bool idle = midiMessages.isEmpty()
+            && patchStage.load() == PatchStage::Idle
+            && !patchXFade.fading
+            && engine->isSleepy()
+            && math::bufferSilent(samples, numChannels, numSamples, SilenceEps);
+        if (!idle)
+        {
+            idleSamples = 0;
+            sleepReported = false;
+            return false;
+        }
+        if (idleSamples < idleSamplesMax)
+        {
+            idleSamples += numSamples;
+            sleepReported = false;
+            return false;
+        }
+
+        buffer.clear();
+        transport(playHead);
+        transport(numSamples);
+        recorder(samples, numChannels, numSamples);
+
+        // the meters would freeze on their last values, so they get one silent record
+        if (!sleepReported && sharedState.editorExists.load())
+        {
+            telemetryRecord.voiceLevels.fill(0.f);
+            telemetryRecord.modVals.fill(0.f);
+            telemetryRecord.voicesActive = 0;
+            telemetryRecord.envFolMod = 0.f;
+            telemetryRecord.randMod = 0.f;
+            telemetryRecord.partialEnergies.fill(0.f);
+            telemetryRecord.fundamentalHz = 0.f;
+            telemetryRecord.cpu = 0.f;
+            telemetryRecord.scopeRate = telemetry.getScopeRate();
+            telemetry.push(telemetryRecord);
+            sleepReported = true;
+        }
+        return true;
+    }
+
+    void Processor::loadPatchStaged(std::function<void()>&& apply)
+    {
+        const std::lock_guard<std::mutex> lock(patchMutex);
+        statePending.reset();
+        auto stage = patchStage.load();
+        // once the playing engine is frozen it keeps the previous patch, so newer ones apply at once
+        if (!isAudioRunning() || stage == PatchStage::Frozen || stage == PatchStage::Applied)
+        {
+            patchPending = nullptr;
+            apply();
+            // a request the audio thread didn't pick up is void
+            stage = PatchStage::Requested;
+            patchStage.compare_exchange_strong(stage, PatchStage::Idle);
+            return;
+        }
+        // a request the audio thread didn't pick up yet just applies the newest patch
+        patchPending = std::move(apply);
+        stage = PatchStage::Idle;
+        patchStage.compare_exchange_strong(stage, PatchStage::Requested);
+    }
+
+    void Processor::handleAsyncUpdate()
+    {
+        const std::lock_guard<std::mutex> lock(patchMutex);
+        if (patchPending != nullptr)
+        {
+            const auto apply = std::move(patchPending);
+            patchPending = nullptr;
+            apply();
+        }
+        statePending.reset();
+        auto stage = PatchStage::Frozen;
+        patchStage.compare_exchange_strong(stage, PatchStage::Applied);
+    }
+
+    bool Processor::isAudioRunning() const noexcept
+    {
+        static constexpr juce::uint32 TimeoutMs = 200;
+        return juce::Time::getMillisecondCounter() - lastBlockMs.load() < TimeoutMs;
+    }
+
+    void Processor::stagePatch() noexcept
+    {
+        auto stage = patchStage.load();
+        if (stage == PatchStage::Requested)
+        {
+            // one engine plays out at a time, so the next patch waits for the running fade
+            if (patchXFade.fading || !patchStage.compare_exchange_strong(stage, PatchStage::Frozen))
+                return;
+            // the snapshot only changes in modulate, so the patch the message thread applies can't reach it
+            engine->freeze();
+            triggerAsyncUpdate();
+        }
+        else if (stage == PatchStage::Applied)
+        {
+            std::swap(engine, engineOut);
+            engine->reset();
+            patchXFade.init();
+            patchStage.store(PatchStage::Idle);
+        }
+    }
+
     void Processor::processBlock(AudioBufferF& buffer, MidiBuffer& midiMessages)
     {
         const auto numChannels = buffer.getNumChannels();
@@ -577,7 +850,20 @@ namespace audio
         double* samplesUp[] = { samples[0], samples[1] };
         const auto numSamplesUp = numSamples;
 #endif
-        pluginProcessor(samplesUp, midi, transportInfo, numChannels, numSamplesUp);
+        // during a patch change the outgoing engine plays out the previous patch
+        // from a copy of the input and the next patch fades in over it
+        const auto patchFading = patchXFade.fading;
+        if (patchFading)
+        {
+            const auto xSamples = patchXFade.getSamples();
+            double* samplesOut[] = { xSamples[0], xSamples[1] };
+            for (auto ch = 0; ch < numChannels; ++ch)
+                SIMD::copy(samplesOut[ch], samplesUp[ch], numSamplesUp);
+            engineOut->playOut(samplesOut, transportInfo, numChannels, numSamplesUp);
+        }
+        (*engine)(samplesUp, midi, transportInfo, numChannels, numSamplesUp);
+        if (patchFading)
+            patchXFade(samplesUp, numChannels, numSamplesUp);
 #if PPDHasHQ
         oversampler.downsample(samples, numSamples);
 #endif
@@ -8,6 +8,9 @@
 #include "audio/dsp/MixProcessor.h"
 #include "audio/dsp/Oversampler.h"
 #include "audio/dsp/PluginRecorder.h"
+#include "audio/dsp/XFade.h"
+#include <mutex>
+#include <thread>
 
 namespace audio
 {
@@ -27,8 +30,12 @@ namespace audio
     
     struct Processor :
         public juce::AudioProcessor,
-        public Timer
+        public Timer,
+        public juce::AsyncUpdater
     {
+        enum class PatchStage { Idle, Requested, Frozen, Applied };
+        static constexpr double PatchFadeMs = 80.;
+
         using BusesProps = juce::AudioProcessor::BusesProperties;
         using ValueTree = juce::ValueTree;
 
@@ -47,6 +54,27 @@ namespace audio
         void processBlockBypassed(AudioBufferD&, MidiBuffer&) override;
 
         void processBlockOversampler(double* const*, MidiBuffer&, const dsp::Transport::Info&, int, int) noexcept;
+
+        // outputs silence with minimal work once input, midi and voices have been idle for a while
+        // returns true if the block was skipped
+        bool sleep(AudioBufferD&, const MidiBuffer&) noexcept;
+
+        // changes patches without clicks: the audio thread freezes the playing engine on the previous
+        // patch, the message thread calls apply and the other engine fades in over it.
+        // applies at once while no audio is processed
+        // apply
+        void loadPatchStaged(std::function<void()>&&);
+
+        // data, sizeInBytes
+        void applyStateInformation(const void*, int);
+
+        // moves staged patch changes on, once per block after the parameters are modulated
+        void stagePatch() noexcept;
+
+        // applies the staged patch once the playing engine is frozen
+        void handleAsyncUpdate() override;
+
+        bool isAudioRunning() const noexcept;
         
         juce::AudioProcessorEditor* createEditor() override;
         bool hasEditor() const override;
@@ -66,14 +94,29 @@ namespace audio
         bool supportsDoublePrecisionProcessing() const override;
         void forcePrepare();
 
+        // writes the factory patches that are new to this plugin version, off the message thread.
+        // existing files are never overwritten and patches the user deleted stay deleted
+        void installFactoryPatches();
+
+        // the default state of this version, built in memory. the patch browser serves it as the init patch
+        const ValueTree& getInitPatch() const noexcept;
+
 #if PPDHasTuningEditor
         XenManager xenManager;
 #endif
         Params params;
         State state;
+        // ids the packed parameters of the binary state refer to, and their hash
+        juce::String stateLayout;
+        uint32_t stateLayoutHash;
+        std::vector<float> stateFloats;
 
         dsp::Transport transport;
-        PluginProcessor pluginProcessor;
+        SharedState sharedState;
+        // the engines swap at every patch change: one plays the current patch, the other one plays out
+        // the previous patch while they crossfade. the editor reaches the shared state through pluginProcessor
+        PluginProcessor pluginProcessor, pluginProcessorAlt;
+        PluginProcessor *engine, *engineOut;
         AudioBufferD audioBufferD;
         MidiBuffer midiSubBuffer, midiOutBuffer;
 
@@ -84,7 +127,28 @@ namespace audio
         dsp::Oversampler oversampler;
 #endif
         double sampleRateUp;
-        int blockSizeUp;
+        int blockSizeUp, idleSamples, idleSamplesMax;
+
+        dsp::XFade patchXFade;
+        // the host and the message thread stage patches, the lock keeps their applies apart
+        std::mutex patchMutex;
+        std::function<void()> patchPending;
+        // a staged host state, hosts that read their state back before it applied get it as they set it
+        juce::MemoryBlock statePending;
+        std::atomic<PatchStage> patchStage;
+        std::atomic<juce::uint32> lastBlockMs;
+
+        // filled once per block while the editor exists
+        dsp::Telemetry telemetry;
+        dsp::Telemetry::Record telemetryRecord;
+        // true once the editor got the silent record of the current sleep
+        bool sleepReported;
+        // writes the factory patches, joined before the instance dies, so that the module can't unload under it
+        std::thread factoryInstaller;
+        ValueTree initPatch;
+
+        // builds initPatch from the default parameters and materials without touching state
+        void makeInitPatch();
 
         //JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(Processor)
     };
@@ -54,25 +54,25 @@ namespace math
 		}
     }
 
+    // eps is compared against the squared samples, the default is about -60 dBFS
     template<typename Float>
-    inline bool bufferSilent(Float* smpls, int numSamples) noexcept
+    inline bool bufferSilent(Float* smpls, int numSamples, Float eps = static_cast<Float>(1e-6)) noexcept
     {
-        static constexpr auto Eps = static_cast<Float>(1e-6);
         for (auto s = 0; s < numSamples; ++s)
         {
             const auto smpl = smpls[s];
-            if (smpl * smpl > Eps)
+            if (smpl * smpl > eps)
                 return false;
         }
         return true;
     }
 
     template<typename Float>
-    inline bool bufferSilent(Float** samples, int numChannels, int numSamples) noexcept
+    inline bool bufferSilent(Float** samples, int numChannels, int numSamples,
+        Float eps = static_cast<Float>(1e-6)) noexcept
     {
-        static constexpr auto Eps = static_cast<Float>(1e-6);
         for (auto ch = 0; ch < numChannels; ++ch)
-			if (!bufferSilent(samples[ch], numSamples))
+			if (!bufferSilent(samples[ch], numSamples, eps))
 				return false;
         return true;
     }
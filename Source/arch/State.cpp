@@ -47,6 +47,33 @@ namespace arch
 		xmlFile.appendText(state.toXmlString());
 	}
 
+	void State::savePatch(MemoryBlock& destData, uint32_t layout,
+		const std::vector<float>& floats, const String& layoutIds) const
+	{
+		juce::MemoryOutputStream treeStream;
+		state.writeToStream(treeStream);
+		const auto layoutUTF8 = layoutIds.toUTF8();
+		const auto layoutSize = static_cast<uint32_t>(layoutUTF8.sizeInBytes() - 1);
+
+		const auto floatsSize = floats.size() * sizeof(float);
+		const BinaryHeader header
+		{
+			BinaryHeader::Magic,
+			BinaryHeader::Version,
+			layout,
+			static_cast<uint32_t>(floats.size()),
+			static_cast<uint32_t>(treeStream.getDataSize())
+		};
+
+		destData.setSize(0);
+		destData.ensureSize(sizeof(BinaryHeader) + floatsSize + treeStream.getDataSize() + sizeof(uint32_t) + layoutSize);
+		destData.append(&header, sizeof(BinaryHeader));
+		destData.append(floats.data(), floatsSize);
+		destData.append(treeStream.getData(), treeStream.getDataSize());
+		destData.append(&layoutSize, sizeof(uint32_t));
+		destData.append(layoutUTF8.getAddress(), layoutSize);
+	}
+
 	void State::loadPatch(const XML& xmlState)
 	{
 		if (xmlState.get() != nullptr)
@@ -79,55 +106,119 @@ namespace arch
 		state = vt;
 	}
 
+	bool State::loadPatch(const void* data, int sizeInBytes, uint32_t& layout,
+		std::vector<float>& floats, String& layoutIds)
+	{
+		const auto size = static_cast<size_t>(sizeInBytes);
+		if (sizeInBytes < 0 || size < sizeof(BinaryHeader))
+			return false;
+		BinaryHeader header;
+		std::memcpy(&header, data, sizeof(BinaryHeader));
+		if (header.magic != BinaryHeader::Magic || header.version > BinaryHeader::Version)
+			return false;
+		const auto floatsSize = static_cast<size_t>(header.numFloats) * sizeof(float);
+		if (sizeof(BinaryHeader) + floatsSize + header.treeSize > size)
+			return false;
+
+		auto bytes = static_cast<const char*>(data) + sizeof(BinaryHeader);
+		floats.resize(header.numFloats);
+		std::memcpy(floats.data(), bytes, floatsSize);
+		bytes += floatsSize;
+
+		const auto vt = ValueTree::readFromData(bytes, header.treeSize);
+		if (vt.hasType(state.getType()))
+			state = vt;
+		layout = header.layout;
+		bytes += header.treeSize;
+
+		static const juce::Identifier LayoutID("layout");
+		layoutIds = state.getProperty(LayoutID).toString();
+		state.removeProperty(LayoutID, nullptr);
+		const auto layoutOffset = sizeof(BinaryHeader) + floatsSize + header.treeSize;
+		if (header.version >= 2 && layoutOffset + sizeof(uint32_t) <= size)
+		{
+			uint32_t layoutSize = 0;
+			std::memcpy(&layoutSize, bytes, sizeof(uint32_t));
+			bytes += sizeof(uint32_t);
+			if (layoutOffset + sizeof(uint32_t) + layoutSize <= size)
+				layoutIds = String::fromUTF8(bytes, static_cast<int>(layoutSize));
+		}
+		return true;
+	}
+
 	using StringArray = juce::StringArray;
 
-	void State::set(const String& path, Var&& var)
+	// StatePath
+
+	StatePath::StatePath() :
+		nodes(),
+		property(),
+		node()
+	{}
+
+	StatePath::StatePath(const String& path) :
+		nodes(),
+		property(),
+		node()
 	{
 		StringArray tokens;
 		tokens.addTokens(path, "/", "\"");
-
+		if (tokens.isEmpty())
+			return;
 		const auto lastToken = tokens.size() - 1;
-		
-		auto child = state;
-		
-		for (auto t = 0; t < tokens.size(); ++t)
-		{
-			if (t == lastToken)
-			{
-				child.setProperty(tokens[t], var, nullptr);
-				return;
-			}
+		nodes.reserve(lastToken);
+		for (auto t = 0; t < lastToken; ++t)
+			nodes.emplace_back(tokens[t]);
+		property = tokens[lastToken];
+	}
 
-			auto nChild = child.getChildWithName(tokens[t]);
-			if (!nChild.isValid())
-			{
-				nChild = ValueTree(tokens[t]);
-				child.appendChild(nChild, nullptr);
-			}
-			child = nChild;
-		}
+	// State
+
+	void State::set(const String& path, Var&& var)
+	{
+		set(StatePath(path), std::move(var));
 	}
 
 	const Var* State::get(const String& path) const
 	{
-		StringArray tokens;
-		tokens.addTokens(path, "/", "\"");
-		
-		const auto lastToken = tokens.size() - 1;
-
-		auto child = state;
+		return get(StatePath(path));
+	}
 
-		for (auto t = 0; t < tokens.size(); ++t)
+	void State::set(const StatePath& path, Var&& var)
+	{
+		// the cached node is stale once the whole state got replaced
+		if (!path.node.isValid() || path.node.getRoot() != state)
 		{
-			if (t == lastToken)
-				return child.getPropertyPointer(tokens[t]);
+			auto child = state;
+			for (const auto& name : path.nodes)
+			{
+				auto nChild = child.getChildWithName(name);
+				if (!nChild.isValid())
+				{
+					nChild = ValueTree(name);
+					child.appendChild(nChild, nullptr);
+				}
+				child = nChild;
+			}
+			path.node = child;
+		}
+		path.node.setProperty(path.property, var, nullptr);
+	}
 
-			auto nChild = child.getChildWithName(tokens[t]);
-			if (!nChild.isValid())
-				return nullptr;
-			child = nChild;
+	const Var* State::get(const StatePath& path) const
+	{
+		if (!path.node.isValid() || path.node.getRoot() != state)
+		{
+			auto child = state;
+			for (const auto& name : path.nodes)
+			{
+				child = child.getChildWithName(name);
+				if (!child.isValid())
+					return nullptr;
+			}
+			path.node = child;
 		}
-		return nullptr;
+		return path.node.getPropertyPointer(path.property);
 	}
 
 	// set and get for global state
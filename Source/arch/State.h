@@ -13,7 +13,33 @@ namespace arch
 	using XMLDoc = juce::XmlDocument;
 	using Proc = juce::AudioProcessor;
 	using Props = juce::ApplicationProperties;
+
+	// the host session format: this header, numFloats packed floats, treeSize bytes
+	// of the remaining state tree in juce's binary format, then layoutSize bytes of the
+	// comma separated parameter ids the floats belong to. patch files stay xml.
+	// version 1 kept the ids in the tree's "layout" property
+	struct BinaryHeader
+	{
+		static constexpr uint32_t Magic = 0x424d4e48; // "HNMB"
+		static constexpr uint32_t Version = 2;
+
+		uint32_t magic, version, layout, numFloats, treeSize;
+	};
 	
+	// a path like "params/gain/value", tokenized once into identifiers.
+	// get and set with it do no string work and reuse the node they resolved last
+	struct StatePath
+	{
+		StatePath();
+
+		// paths like "params/param/gain/value"
+		explicit StatePath(const String&);
+
+		std::vector<juce::Identifier> nodes;
+		juce::Identifier property;
+		mutable ValueTree node;
+	};
+
 	struct State
 	{
 		State();
@@ -24,6 +50,9 @@ namespace arch
 
 		void savePatch(const File&) const;
 
+		// destData, layout, floats, layoutIds
+		void savePatch(MemoryBlock&, uint32_t, const std::vector<float>&, const String&) const;
+
 		void loadPatch(const XML&);
 
 		/* processor, data, sizeInBytes */
@@ -35,12 +64,20 @@ namespace arch
 		void loadPatch(const File&);
 
 		void loadPatch(const ValueTree&);
+
+		// data, sizeInBytes, layout, floats, layoutIds; returns false if data is not binary state
+		bool loadPatch(const void*, int, uint32_t&, std::vector<float>&, String&);
 		
 		// path, var; paths like "params/param/gain/value"
 		void set(const String&, Var&&);
 
 		// paths like "params/param/gain/value"
 		const Var* get(const String&) const;
+
+		// path, var
+		void set(const StatePath&, Var&&);
+
+		const Var* get(const StatePath&) const;
 		
 		ValueTree state;
 		Props props;
@@ -1,57 +1,78 @@
 #include "PluginProcessor.h"
 #include <juce_core/juce_core.h>
+#include <bit>
 
 namespace audio
 {
-	PluginProcessor::PluginProcessor(Params& _params, arch::XenManager& _xen) :
-		params(_params), xen(_xen), sampleRate(1.),
+	// SharedState
+
+	SharedState::SharedState() :
+		Timer(),
 		keySelector(),
-		monophonyHandler(), autoMPE(), voiceSplit(),
-		parallelProcessor(), formantLayer(),
-		envGensAmp(), envGensMod(), envFolMod(),
-		randMod(),
-		getModValFuncs(),
-		noiseSynth(),
-		modalFilter(), formantFilter(), combFilter(), lowpass(),
+		materials(),
 		editorExists(false),
 		recording(-1),
 		recSampleIndex(0)
 	{
-		getModValFuncs[0] = [&](int v, int numSamplesEvt, int)
-		{
-			// ENVELOPE GENERATOR
-			const auto envGenModInfo = envGensMod(v, numSamplesEvt);
-			const auto envGenModVal = envGenModInfo.active ? envGenModInfo[0] : 0.;
-			return envGenModVal;
-		};
-		getModValFuncs[1] = [&](int, int, int s)
-		{
-			// ENVELOPE FOLLOWER
-			const auto envFolModVal = envFolMod.isSleepy() ? 0. : envFolMod[s];
-			return envFolModVal;
-		};
-		getModValFuncs[2] = [&](int, int, int s)
-		{
-			// RANDOMIZER
-			return randMod[s];
-		};
-
 		startTimerHz(2);
+	}
 
-		xen.updateFunc = [&](const arch::XenManager::Info&, int numChannels)
+	void SharedState::timerCallback()
+	{
+		const auto edtrExists = !editorExists.load();
+		if (edtrExists)
+			return;
+		for (auto i = 0; i < 2; ++i)
 		{
-			modalFilter.triggerXen(xen, numChannels);
-			combFilter.triggerXen(xen, numChannels);
-			lowpass.triggerXen(xen, numChannels);
-		};
+			auto& material = materials.getMaterial(i);
+			auto& status = material.status;
+			status.store(dsp::modal::StatusMat::Processing);
+		}
+	}
+
+	// PluginProcessor
+
+	PluginProcessor::PluginProcessor(Params& _params, arch::XenManager& _xen, SharedState& shared) :
+		params(_params), xen(_xen), sampleRate(1.),
+		keySelector(shared.keySelector),
+		monophonyHandler(), autoMPE(), voiceSplit(),
+		parallelProcessor(), polyGovernor(), voiceStealer(),
+		voiceEnergies(), pendingNoteOns(), formantLayer(),
+		envGensAmp(), envGensMod(), envFolMod(),
+		envGenAmpVersion(0),
+		randMod(),
+		modVals(),
+		modMatrix(),
+		modSources(),
+		noiseSynth(),
+		modalFilter(shared.materials), formantFilter(), combFilter(), lowpass(),
+		editorExists(shared.editorExists),
+		frozenSnapshot(),
+		midiNone(),
+		frozen(false),
+		recording(shared.recording),
+		recSampleIndex(shared.recSampleIndex),
+		polyphony(dsp::NumMPEChannels)
+	{
 	}
 
 	void PluginProcessor::prepare(double _sampleRate)
 	{
 		sampleRate = _sampleRate;
+		frozen = false;
 		keySelector.prepare();
+		polyGovernor.prepare(sampleRate);
+		voiceStealer.prepare(sampleRate);
+		voiceEnergies.fill(0.);
+		for (auto& pending : pendingNoteOns)
+			pending.noteNumber = -1.;
 		envGensAmp.prepare(sampleRate);
+		envGenAmpVersion = 0;
 		envGensMod.prepare(sampleRate);
+		modVals.fill(0.);
+		modMatrix.prepare();
+		for (auto& sources : modSources)
+			sources.fill(0.);
 		envFolMod.prepare(sampleRate);
 		randMod.prepare(sampleRate);
 		modalFilter.prepare(sampleRate);
@@ -64,60 +85,106 @@ namespace audio
 		dsp::MidiBuffer& midi, const dsp::Transport::Info& transport,
 		int numChannels, int numSamples) noexcept
 	{
-		const auto& envGenAmpAttackParam = params(PID::EnvGenAmpAttack);
-		const auto envGenAmpAttack = static_cast<double>(envGenAmpAttackParam.getValModDenorm());
-		const auto& envGenAmpDecayParam = params(PID::EnvGenAmpDecay);
-		const auto envGenAmpDecay = static_cast<double>(envGenAmpDecayParam.getValModDenorm());
-		const auto& envGenAmpSustainParam = params(PID::EnvGenAmpSustain);
-		const auto envGenAmpSustain = static_cast<double>(envGenAmpSustainParam.getValModDenorm());
-		const auto& envGenAmpReleaseParam = params(PID::EnvGenAmpRelease);
-		const auto envGenAmpRelease = static_cast<double>(envGenAmpReleaseParam.getValModDenorm());
-		envGensAmp.updateParametersMs({ envGenAmpAttack, envGenAmpDecay, envGenAmpSustain, envGenAmpRelease });
-
-		const auto& modSelectParam = params(PID::ModSelect);
-		const auto modSelect = static_cast<int>(std::round(modSelectParam.getValModDenorm()));
-		enum { kEnvGen, kEnvMod, kRandMod, kNumModulators };
-
-		if (modSelect == kEnvGen)
+		process(samples, midi, transport, numChannels, numSamples, true);
+	}
+
+	void PluginProcessor::playOut(double** samples, const dsp::Transport::Info& transport,
+		int numChannels, int numSamples) noexcept
+	{
+		process(samples, midiNone, transport, numChannels, numSamples, false);
+	}
+
+	void PluginProcessor::freeze() noexcept
+	{
+		frozenSnapshot = params.getSnapshot();
+		frozen = true;
+	}
+
+	void PluginProcessor::reset() noexcept
+	{
+		silence();
+		monophonyHandler.reset();
+		autoMPE.reset();
+		voiceEnergies.fill(0.);
+		modVals.fill(0.);
+		frozen = false;
+		// the snapshot's versions moved on while frozen, 0 updates everything at the next block
+		envGenAmpVersion = 0;
+		modMatrix.prepare();
+		modalFilter.updateMaterials();
+		// the keys held by the other engine start again on this one
+		keySelector.prepare();
+	}
+
+	void PluginProcessor::triggerXen(int numChannels) noexcept
+	{
+		modalFilter.triggerXen(xen, numChannels);
+		combFilter.triggerXen(xen, numChannels);
+		lowpass.triggerXen(xen, numChannels);
+	}
+
+	const param::ParamSnapshot& PluginProcessor::getSnapshot() const noexcept
+	{
+		return frozen ? frozenSnapshot : params.getSnapshot();
+	}
+
+	void PluginProcessor::process(double** samples,
+		dsp::MidiBuffer& midi, const dsp::Transport::Info& transport,
+		int numChannels, int numSamples, bool live) noexcept
+	{
+		const auto& snap = getSnapshot();
+		polyGovernor.begin(snap.getNorm(PID::PolyGovernor) > .5f);
+
+		const auto envGenAmpAttack = static_cast<double>(snap(PID::EnvGenAmpAttack));
+		const auto envGenAmpDecay = static_cast<double>(snap(PID::EnvGenAmpDecay));
+		const auto envGenAmpSustain = static_cast<double>(snap(PID::EnvGenAmpSustain));
+		const auto envGenAmpRelease = static_cast<double>(snap(PID::EnvGenAmpRelease));
+		const auto envGenAmpVersionCur = snap.getVersion
+		({
+			PID::EnvGenAmpAttack, PID::EnvGenAmpDecay, PID::EnvGenAmpSustain, PID::EnvGenAmpRelease
+		});
+		if (envGenAmpVersion != envGenAmpVersionCur)
+		{
+			envGenAmpVersion = envGenAmpVersionCur;
+			envGensAmp.updateParametersMs({ envGenAmpAttack, envGenAmpDecay, envGenAmpSustain, envGenAmpRelease });
+		}
+
+		const auto modSelect = static_cast<int>(std::round(snap(PID::ModSelect)));
+		modMatrix.compile(snap);
+		// the stages' env depths follow the selected modulator, the mod matrix can read the others as well
+		const auto isModUsed = [&](int modType)
 		{
-			const auto& envGenModTemposyncParam = params(PID::EnvGenModTemposync);
-			const auto envGenModTemposync = envGenModTemposyncParam.getValMod() > .5f;
-			const auto& envGenModSustainParam = params(PID::EnvGenModSustain);
-			const auto envGenModSustain = static_cast<double>(envGenModSustainParam.getValModDenorm());
+			return modSelect == modType || modMatrix.uses(static_cast<dsp::ModMatrix::Source>(modType));
+		};
+
+		if (isModUsed(kEnvGen))
+		{
+			const auto envGenModTemposync = snap.getNorm(PID::EnvGenModTemposync) > .5f;
+			const auto envGenModSustain = static_cast<double>(snap(PID::EnvGenModSustain));
 			if (envGenModTemposync)
 			{
-				const auto& envGenModAttackParam = params(PID::EnvGenModAttackTS);
-				const auto envGenModAttack = static_cast<double>(envGenModAttackParam.getValModDenorm());
-				const auto& envGenModDecayParam = params(PID::EnvGenModDecayTS);
-				const auto envGenModDecay = static_cast<double>(envGenModDecayParam.getValModDenorm());
-				const auto& envGenModReleaseParam = params(PID::EnvGenModReleaseTS);
-				const auto envGenModRelease = static_cast<double>(envGenModReleaseParam.getValModDenorm());
+				const auto envGenModAttack = static_cast<double>(snap(PID::EnvGenModAttackTS));
+				const auto envGenModDecay = static_cast<double>(snap(PID::EnvGenModDecayTS));
+				const auto envGenModRelease = static_cast<double>(snap(PID::EnvGenModReleaseTS));
 				envGensMod.updateParametersSync({ envGenModAttack, envGenModDecay, envGenModSustain, envGenModRelease }, transport.bpm);
 			}
 			else
 			{
-				const auto& envGenModAttackParam = params(PID::EnvGenModAttack);
-				const auto envGenModAttack = static_cast<double>(envGenModAttackParam.getValModDenorm());
-				const auto& envGenModDecayParam = params(PID::EnvGenModDecay);
-				const auto envGenModDecay = static_cast<double>(envGenModDecayParam.getValModDenorm());
-				const auto& envGenModReleaseParam = params(PID::EnvGenModRelease);
-				const auto envGenModRelease = static_cast<double>(envGenModReleaseParam.getValModDenorm());
+				const auto envGenModAttack = static_cast<double>(snap(PID::EnvGenModAttack));
+				const auto envGenModDecay = static_cast<double>(snap(PID::EnvGenModDecay));
+				const auto envGenModRelease = static_cast<double>(snap(PID::EnvGenModRelease));
 				envGensMod.updateParametersMs({ envGenModAttack, envGenModDecay, envGenModSustain, envGenModRelease });
 			}
 		}
-		else if (modSelect == kEnvMod)
+		if (isModUsed(kEnvMod))
 		{
-			const auto& envFolModGainParam = params(PID::EnvFolModGain);
-			const auto envFolModGainDb = static_cast<double>(envFolModGainParam.getValModDenorm());
+			const auto envFolModGainDb = static_cast<double>(snap(PID::EnvFolModGain));
 
-			const auto& envFolModAtkParam = params(PID::EnvFolModAttack);
-			const auto envFolModAtkMs = static_cast<double>(envFolModAtkParam.getValModDenorm());
+			const auto envFolModAtkMs = static_cast<double>(snap(PID::EnvFolModAttack));
 
-			const auto& envFolModDcyParam = params(PID::EnvFolModDecay);
-			const auto envFolModDcyMs = static_cast<double>(envFolModDcyParam.getValModDenorm());
+			const auto envFolModDcyMs = static_cast<double>(snap(PID::EnvFolModDecay));
 
-			const auto& envFolModSmoothParam = params(PID::EnvFolModSmooth);
-			const auto envFolModSmoothMs = static_cast<double>(envFolModSmoothParam.getValModDenorm());
+			const auto envFolModSmoothMs = static_cast<double>(snap(PID::EnvFolModSmooth));
 
 			const dsp::EnvelopeFollower::Params envFolModParams
 			{
@@ -126,28 +193,23 @@ namespace audio
 
 			envFolMod(samples, envFolModParams, numChannels, numSamples);
 		}
-		else if (modSelect == kRandMod)
+		if (isModUsed(kRandMod))
 		{
-			const auto& randModRateSyncParam = params(PID::RandModRateSync);
-			const auto randModRateSync = static_cast<double>(randModRateSyncParam.getValModDenorm());
+			const auto randModRateSync = static_cast<double>(snap(PID::RandModRateSync));
 
-			const auto& randModSmoothParam = params(PID::RandModSmooth);
-			const auto randModSmooth = static_cast<double>(randModSmoothParam.getValMod());
+			const auto randModSmooth = static_cast<double>(snap.getNorm(PID::RandModSmooth));
 
-			const auto& randModComplexParam = params(PID::RandModComplex);
-			const auto randModComplex = static_cast<double>(randModComplexParam.getValModDenorm());
+			const auto randModComplex = static_cast<double>(snap(PID::RandModComplex));
 
-			const auto& randModDropoutParam = params(PID::RandModDropout);
-			const auto randModDropout = static_cast<double>(randModDropoutParam.getValMod());
+			const auto randModDropout = static_cast<double>(snap.getNorm(PID::RandModDropout));
 
 			randMod({ randModRateSync, randModSmooth, randModComplex, randModDropout }, transport, numSamples);
 		}
 
-		const auto& noiseBlendParam = params(PID::NoiseBlend);
-		const auto noiseBlend = noiseBlendParam.getValMod();
+		const auto noiseBlend = snap.getNorm(PID::NoiseBlend);
 		noiseSynth(samples, noiseBlend, numChannels, numSamples);
 
-		const auto recordingIndex = recording.load();
+		const auto recordingIndex = live ? recording.load() : -1;
 		if (recordingIndex != -1)
 		{
 			auto& material = modalFilter.getMaterial(recordingIndex);
@@ -183,57 +245,44 @@ namespace audio
 		const auto edoInt = static_cast<int>(std::round(edo));
 		const auto edoInPoly = edoInt < 15 ? edoInt : 15;
 
-		const auto& polyParam = params(PID::Polyphony);
 		
-		const auto& keySelectorEnabledParam = params(PID::KeySelectorEnabled);
-		const auto keySelectorEnabled = keySelectorEnabledParam.getValMod() > .5f;
-		const auto polyphony = keySelectorEnabled ? edoInPoly : static_cast<int>(std::round(polyParam.getValModDenorm()));
-		monophonyHandler(midi, polyphony);
-		keySelector(midi, xen, keySelectorEnabled, transport.playing);
-		autoMPE(midi, polyphony);
+		const auto keySelectorEnabled = snap.getNorm(PID::KeySelectorEnabled) > .5f;
+		polyphony = keySelectorEnabled ? edoInPoly : static_cast<int>(std::round(snap(PID::Polyphony)));
+		if (live)
+		{
+			monophonyHandler(midi, polyphony);
+			keySelector(midi, xen, keySelectorEnabled, transport.playing);
+			// inaudible tails count as idle, so that new notes don't wait for their retrigger fade
+			for (auto v = 0; v < dsp::NumMPEChannels; ++v)
+				voiceEnergies[v] = parallelProcessor.isSleepy(v) || !voiceStealer.isAudible(v) ? 0. : voiceStealer.getEnergy(v);
+			autoMPE(midi, voiceEnergies, polyphony);
+		}
 		voiceSplit(midi, numSamples);
 
-		const auto& modalOctParam = params(PID::ModalOct);
-		const auto& modalSemiParam = params(PID::ModalSemi);
-		auto modalSemi = static_cast<double>(std::round(modalSemiParam.getValModDenorm()));
-		modalSemi += static_cast<double>(std::round(modalOctParam.getValModDenorm())) * edo;
+		auto modalSemi = static_cast<double>(std::round(snap(PID::ModalSemi)));
+		modalSemi += static_cast<double>(std::round(snap(PID::ModalOct))) * edo;
 
 		modalFilter.setTranspose(xen, modalSemi, numChannels);
 
-		const auto& modalBlendParam = params(PID::ModalBlend);
-		const auto modalBlend = static_cast<double>(modalBlendParam.getValMod());
-		const auto& modalBlendEnvParam = params(PID::ModalBlendEnv);
-		const auto modalBlendEnv = static_cast<double>(modalBlendEnvParam.getValModDenorm());
-		const auto& modalBlendBreiteParam = params(PID::ModalBlendBreite);
-		const auto modalBlendBreite = static_cast<double>(modalBlendBreiteParam.getValModDenorm());
-
-		const auto& modalSpreizungParam = params(PID::ModalSpreizung);
-		const auto modalSpreizung = static_cast<double>(modalSpreizungParam.getValModDenorm());
-		const auto& modalSpreizungEnvParam = params(PID::ModalSpreizungEnv);
-		const auto modalSpreizungEnv = static_cast<double>(modalSpreizungEnvParam.getValModDenorm());
-		const auto& modalSpreizungBreiteParam = params(PID::ModalSpreizungBreite);
-		const auto modalSpreizungBreite = static_cast<double>(modalSpreizungBreiteParam.getValModDenorm());
-
-		const auto& modalHarmonieParam = params(PID::ModalHarmonie);
-		const auto modalHarmonie = static_cast<double>(modalHarmonieParam.getValMod());
-		const auto& modalHarmonieEnvParam = params(PID::ModalHarmonieEnv);
-		const auto modalHarmonieEnv = static_cast<double>(modalHarmonieEnvParam.getValModDenorm());
-		const auto& modalHarmonieBreiteParam = params(PID::ModalHarmonieBreite);
-		const auto modalHarmonieBreite = static_cast<double>(modalHarmonieBreiteParam.getValModDenorm());
-
-		const auto& modalKraftParam = params(PID::ModalKraft);
-		const auto modalKraft = static_cast<double>(modalKraftParam.getValModDenorm());
-		const auto& modalKraftEnvParam = params(PID::ModalKraftEnv);
-		const auto modalKraftEnv = static_cast<double>(modalKraftEnvParam.getValModDenorm());
-		const auto& modalKraftBreiteParam = params(PID::ModalKraftBreite);
-		const auto modalKraftBreite = static_cast<double>(modalKraftBreiteParam.getValModDenorm());
-
-		const auto& modalResoParam = params(PID::ModalResonanz);
-		const auto modalReso = static_cast<double>(modalResoParam.getValMod());
-		const auto& modalResoEnvParam = params(PID::ModalResonanzEnv);
-		const auto modalResoEnv = static_cast<double>(modalResoEnvParam.getValModDenorm());
-		const auto& modalResoBreiteParam = params(PID::ModalResonanzBreite);
-		const auto modalResoBreite = static_cast<double>(modalResoBreiteParam.getValModDenorm());
+		const auto modalBlend = static_cast<double>(snap.getNorm(PID::ModalBlend));
+		const auto modalBlendEnv = static_cast<double>(snap(PID::ModalBlendEnv));
+		const auto modalBlendBreite = static_cast<double>(snap(PID::ModalBlendBreite));
+
+		const auto modalSpreizung = static_cast<double>(snap(PID::ModalSpreizung));
+		const auto modalSpreizungEnv = static_cast<double>(snap(PID::ModalSpreizungEnv));
+		const auto modalSpreizungBreite = static_cast<double>(snap(PID::ModalSpreizungBreite));
+
+		const auto modalHarmonie = static_cast<double>(snap.getNorm(PID::ModalHarmonie));
+		const auto modalHarmonieEnv = static_cast<double>(snap(PID::ModalHarmonieEnv));
+		const auto modalHarmonieBreite = static_cast<double>(snap(PID::ModalHarmonieBreite));
+
+		const auto modalKraft = static_cast<double>(snap(PID::ModalKraft));
+		const auto modalKraftEnv = static_cast<double>(snap(PID::ModalKraftEnv));
+		const auto modalKraftBreite = static_cast<double>(snap(PID::ModalKraftBreite));
+
+		const auto modalReso = static_cast<double>(snap.getNorm(PID::ModalResonanz));
+		const auto modalResoEnv = static_cast<double>(snap(PID::ModalResonanzEnv));
+		const auto modalResoBreite = static_cast<double>(snap(PID::ModalResonanzBreite));
 
 		const dsp::modal::Voice::Parameters modalParams
 		(
@@ -242,16 +291,15 @@ namespace audio
 			modalBlendBreite, modalSpreizungBreite, modalHarmonieBreite, modalKraftBreite, modalResoBreite
 		);
 
-		modalFilter();
+		// a frozen engine keeps the materials of its patch
+		if (!frozen)
+			modalFilter();
+		modalFilter.setMeasureEnergies(editorExists.load());
 
-		const auto& formantDecayParam = params(PID::FormantDecay);
-		const auto formantDecay = static_cast<double>(formantDecayParam.getValModDenorm());
-		const auto& formantGainDbParam = params(PID::FormantGain);
-		const auto formantGainDb = static_cast<double>(formantGainDbParam.getValModDenorm());
-		const auto& formantAParam = params(PID::FormantA);
-		const auto formantVowelA = static_cast<int>(std::round(formantAParam.getValModDenorm()));
-		const auto& formantBParam = params(PID::FormantB);
-		const auto formantVowelB = static_cast<int>(std::round(formantBParam.getValModDenorm()));
+		const auto formantDecay = static_cast<double>(snap(PID::FormantDecay));
+		const auto formantGainDb = static_cast<double>(snap(PID::FormantGain));
+		const auto formantVowelA = static_cast<int>(std::round(snap(PID::FormantA)));
+		const auto formantVowelB = static_cast<int>(std::round(snap(PID::FormantB)));
 
 		formantFilter.updateParameters
 		(
@@ -260,60 +308,64 @@ namespace audio
 			static_cast<dsp::formant::VowelClass>(formantVowelB)
 		);
 
-		const auto& formantPosParam = params(PID::FormantPos);
-		const auto formantPos = static_cast<double>(formantPosParam.getValMod());
-		const auto& formantPosEnvParam = params(PID::FormantPosEnv);
-		const auto formantPosEnv = static_cast<double>(formantPosEnvParam.getValModDenorm());
-		const auto& formantPosWidthParam = params(PID::FormantPosWidth);
-		const auto formantPosWidth = static_cast<double>(formantPosWidthParam.getValModDenorm());
+		const auto formantPos = static_cast<double>(snap.getNorm(PID::FormantPos));
+		const auto formantPosEnv = static_cast<double>(snap(PID::FormantPosEnv));
+		const auto formantPosWidth = static_cast<double>(snap(PID::FormantPosWidth));
 
-		const auto& formantQParam = params(PID::FormantQ);
-		const auto formantQ = static_cast<double>(formantQParam.getValMod());
-		const auto& formantQEnvParam = params(PID::FormantQEnv);
-		const auto formantQEnv = static_cast<double>(formantQEnvParam.getValModDenorm());
-		const auto& formantQWidthParam = params(PID::FormantQWidth);
-		const auto formantQWidth = static_cast<double>(formantQWidthParam.getValModDenorm());
+		const auto formantQ = static_cast<double>(snap.getNorm(PID::FormantQ));
+		const auto formantQEnv = static_cast<double>(snap(PID::FormantQEnv));
+		const auto formantQWidth = static_cast<double>(snap(PID::FormantQWidth));
 
 		dsp::formant::Params formantParams
 		(
 			formantPos, formantQ, formantPosEnv, formantQEnv, formantPosWidth, formantQWidth
 		);
 
-		const auto& combOctParam = params(PID::CombOct);
-		const auto combOct = std::round(static_cast<double>(combOctParam.getValModDenorm()));
-		const auto& combSemiParam = params(PID::CombSemi);
-		auto combSemi = static_cast<double>(std::round(combSemiParam.getValModDenorm()));
+		const auto combOct = std::round(static_cast<double>(snap(PID::CombOct)));
+		auto combSemi = static_cast<double>(std::round(snap(PID::CombSemi)));
 		combSemi += combOct * edo;
 
-		const auto& combUnisonParam = params(PID::CombUnison);
-		const auto combUnison = static_cast<double>(combUnisonParam.getValMod());
+		const auto combUnison = static_cast<double>(snap.getNorm(PID::CombUnison));
 
-		const auto& combFeedbackParam = params(PID::CombFeedback);
-		const auto combFeedback = static_cast<double>(combFeedbackParam.getValModDenorm());
-		const auto& combFeedbackEnvParam = params(PID::CombFeedbackEnv);
-		const auto combFeedbackEnv = static_cast<double>(combFeedbackEnvParam.getValModDenorm());
-		const auto& combFeedbackWidthParam = params(PID::CombFeedbackWidth);
-		const auto combFeedbackWidth = static_cast<double>(combFeedbackWidthParam.getValModDenorm());
+		const auto combFeedback = static_cast<double>(snap(PID::CombFeedback));
+		const auto combFeedbackEnv = static_cast<double>(snap(PID::CombFeedbackEnv));
+		const auto combFeedbackWidth = static_cast<double>(snap(PID::CombFeedbackWidth));
+		const auto combChord = static_cast<dsp::hnm::ChordType>(static_cast<int>(std::round(snap(PID::CombChord))));
+		const auto combChordDepth = static_cast<double>(snap(PID::CombChordDepth));
 
 		const dsp::hnm::Params combParams
 		(
-			combSemi, combUnison, combFeedback, combFeedbackEnv, combFeedbackWidth
+			combSemi, combUnison, combFeedback, combFeedbackEnv, combFeedbackWidth,
+			combChordDepth, combChord
 		);
 
-		const auto& dampParam = params(PID::Damp);
-		const auto damp = static_cast<double>(dampParam.getValModDenorm()) * edo;
-		const auto& dampEnvParam = params(PID::DampEnv);
-		const auto dampEnv = static_cast<double>(dampEnvParam.getValModDenorm()) * edo;
-		const auto& dampWidthParam = params(PID::DampWidth);
-		const auto dampWidth = static_cast<double>(dampWidthParam.getValModDenorm()) * edo;
+		const auto damp = static_cast<double>(snap(PID::Damp)) * edo;
+		const auto dampEnv = static_cast<double>(snap(PID::DampEnv)) * edo;
+		const auto dampWidth = static_cast<double>(snap(PID::DampWidth)) * edo;
 
 		const dsp::hnm::lp::Params lpParams(damp, dampEnv, dampWidth);
 
-		const auto samplesInput = const_cast<const double**>(samples);
+		auto modalParamsVoice = modalParams;
+		auto formantParamsVoice = formantParams;
+		auto combParamsVoice = combParams;
+		auto lpParamsVoice = lpParams;
+
+		// voices that sleep and have nothing to react to are skipped entirely
+		auto liveVoices = parallelProcessor.getAwake();
 		for (auto v = 0; v < dsp::NumMPEChannels; ++v)
 		{
+			const bool modRinging = isModUsed(kEnvGen) && !envGensMod.isSleepy(v);
+			if (voiceSplit.hasEvents(v + 2) || modRinging || voiceStealer.isStealing(v))
+				liveVoices |= 1u << v;
+		}
+
+		const auto samplesInput = const_cast<const double**>(samples);
+		for (; liveVoices != 0; liveVoices &= liveVoices - 1u)
+		{
+			const auto v = std::countr_zero(liveVoices);
 			const auto& midiVoice = voiceSplit[v + 2];
 			auto bandVoice = parallelProcessor[v];
+			bool awake = false;
 
 			auto start = 0;
 			for(const auto it: midiVoice)
@@ -332,7 +384,12 @@ namespace audio
 				);
 
 				// synthesize the modulation envelope generator
-				const auto envGenModVal = getModValFuncs[modSelect](v, numSamplesEvt, start);
+				const auto envGenModVal = synthesizeMod(modSelect, v, start, numSamplesEvt);
+				if (!modMatrix.isEmpty())
+				{
+					updateModSources(modSelect, v, start, numSamplesEvt);
+					applyModMatrix(v, edo, modalParamsVoice, formantParamsVoice, combParamsVoice, lpParamsVoice);
+				}
 
 				bool active = envGenAmpActive;
 
@@ -352,7 +409,7 @@ namespace audio
 					modalFilter
 					(
 						samplesVoiceEvt,
-						modalParams,
+						modalParamsVoice,
 						envGenModVal,
 						numChannels,
 						numSamplesEvt,
@@ -362,7 +419,7 @@ namespace audio
 					formantFilter
 					(
 						layerVoiceEvt,
-						formantParams,
+						formantParamsVoice,
 						envGenModVal,
 						numChannels,
 						numSamplesEvt,
@@ -378,7 +435,7 @@ namespace audio
 					combFilter
 					(
 						samplesVoiceEvt, xen,
-						combParams, envGenModVal,
+						combParamsVoice, envGenModVal,
 						numChannels, numSamplesEvt, v
 					);
 				active = active || lowpass.isRinging(v);
@@ -386,28 +443,55 @@ namespace audio
 					lowpass
 					(
 						samplesVoiceEvt,
-						lpParams, xen,
+						lpParamsVoice, xen,
 						envGenModVal,
 						numChannels, numSamplesEvt,
 						v
 					);
 
-				parallelProcessor.setSleepy(!active, v);
+				if (voiceStealer.isStealing(v))
+				{
+					if (!active || voiceStealer(samplesVoiceEvt, numChannels, numSamplesEvt, v))
+					{
+						silence(v);
+						active = false;
+						auto& pending = pendingNoteOns[v];
+						if (pending.noteNumber != -1.)
+						{
+							triggerNoteOn(pending.noteNumber, pending.velocity, numChannels, v, true);
+							pending.noteNumber = -1.;
+						}
+					}
+				}
+				else if (active)
+					voiceStealer.measure(samplesVoiceEvt, numChannels, numSamplesEvt, v);
+
+				awake = awake || active;
 				start = end;
 
 				if (msg.isNoteOn())
 				{
-					envGensAmp.triggerNoteOn(true, v);
-					envGensMod.triggerNoteOn(true, v);
 					const auto noteNumber = static_cast<double>(msg.getNoteNumber());
+					const auto velocity = static_cast<double>(msg.getFloatVelocity());
 					const bool polyphonic = polyphony != 1;
-					modalFilter.triggerNoteOn(xen, noteNumber, numChannels, v, polyphonic);
-					formantFilter.triggerNoteOn(v);
-					combFilter.triggerNoteOn(xen, noteNumber, numChannels, v);
-					lowpass.triggerNoteOn(xen, noteNumber, numChannels, v);
+					if (active && polyphonic && voiceStealer.isAudible(v))
+					{
+						// every voice rings audibly, so the new note waits until this tail faded out
+						if (!voiceStealer.isStealing(v))
+							voiceStealer.steal(v, dsp::VoiceStealer::RetriggerFadeMs);
+						pendingNoteOns[v] = { noteNumber, velocity };
+					}
+					else
+					{
+						// an inaudible tail is cut right away, mono notes keep their legato
+						if (voiceStealer.isStealing(v) || (active && polyphonic))
+							silence(v);
+						triggerNoteOn(noteNumber, velocity, numChannels, v, polyphonic);
+					}
 				}
 				else if (msg.isNoteOff())
 				{
+					pendingNoteOns[v].noteNumber = -1.;
 					envGensAmp.triggerNoteOn(false, v);
 					envGensMod.triggerNoteOn(false, v);
 					modalFilter.triggerNoteOff(v);
@@ -417,6 +501,7 @@ namespace audio
 				}
 				else if (msg.isAllNotesOff())
 				{
+					pendingNoteOns[v].noteNumber = -1.;
 					envGensAmp.triggerNoteOn(false, v);
 					envGensMod.triggerNoteOn(false, v);
 					modalFilter.triggerNoteOff(v);
@@ -433,10 +518,230 @@ namespace audio
 					combFilter.triggerPitchbend(xen, pb, numChannels, v);
 					lowpass.triggerPitchbend(xen, pb, numChannels, v);
 				}
+				else if (msg.isAftertouch())
+					modSources[v][dsp::ModMatrix::kPressure] = static_cast<double>(msg.getAfterTouchValue()) / 127.;
+				else if (msg.isChannelPressure())
+					modSources[v][dsp::ModMatrix::kPressure] = static_cast<double>(msg.getChannelPressureValue()) / 127.;
+				else if (msg.isControllerOfType(74))
+					modSources[v][dsp::ModMatrix::kSlide] = static_cast<double>(msg.getControllerValue()) / 127.;
 			}
+			parallelProcessor.setSleepy(!awake, v);
 		}
 
 		parallelProcessor.joinReplace(samples, numChannels, numSamples);
+		governVoices();
+		polyGovernor.end(numSamples);
+	}
+
+	bool PluginProcessor::isSleepy() const noexcept
+	{
+		if (parallelProcessor.getAwake() != 0 || recording.load() != -1)
+			return false;
+		for (auto v = 0; v < dsp::NumMPEChannels; ++v)
+			if (voiceStealer.isStealing(v) || !envGensMod.isSleepy(v))
+				return false;
+		return true;
+	}
+
+	void PluginProcessor::report(dsp::Telemetry::Record& record) const noexcept
+	{
+		record.voicesActive = 0;
+		record.partialEnergies.fill(0.f);
+		record.fundamentalHz = 0.f;
+		auto loudest = 0.f;
+		for (auto v = 0; v < dsp::NumMPEChannels; ++v)
+		{
+			const auto active = !parallelProcessor.isSleepy(v);
+			if (active)
+				record.voicesActive |= 1 << v;
+			record.voiceLevels[v] = active ? static_cast<float>(voiceStealer.getEnergy(v)) : 0.f;
+			record.modVals[v] = static_cast<float>(modVals[v]);
+			record.envGenAmpStates[v] = envGensAmp.getState(v);
+			record.envGenModStates[v] = envGensMod.getState(v);
+			if (!active || !modalFilter.isRinging(v))
+				continue;
+			for (auto i = 0; i < dsp::modal::NumPartials; ++i)
+				record.partialEnergies[i] += static_cast<float>(modalFilter.getEnergy(i, v));
+			if (record.voiceLevels[v] > loudest)
+			{
+				loudest = record.voiceLevels[v];
+				record.fundamentalHz = static_cast<float>(modalFilter.getFreqHz(v));
+			}
+		}
+		record.polyphony = polyphony;
+		record.envFolMod = static_cast<float>(envFolMod.getMeter());
+		record.randMod = randMod.getMeter();
+	}
+
+	void PluginProcessor::governVoices() noexcept
+	{
+		const auto voiceLimit = polyGovernor.getVoiceLimit();
+		if (voiceLimit >= dsp::NumMPEChannels)
+			return;
+
+		std::array<bool, dsp::NumMPEChannels> sounding, released, settled;
+		auto numSounding = 0;
+		for (auto v = 0; v < dsp::NumMPEChannels; ++v)
+		{
+			sounding[v] = !parallelProcessor.isSleepy(v) && !voiceStealer.isStealing(v);
+			released[v] = sounding[v] && !envGensAmp.isNoteOn(v);
+			// the energy of a voice in its attack still rises from 0, so it would always look quietest
+			settled[v] = sounding[v] && envGensAmp.getState(v) != dsp::EnvelopeGenerator::State::Attack;
+			if (sounding[v])
+				++numSounding;
+		}
+
+		// released tails go first, then held notes past their attack, the newest notes last
+		while (numSounding > voiceLimit)
+		{
+			auto v = voiceStealer.getQuietest(released);
+			if (v == -1)
+				v = voiceStealer.getQuietest(settled);
+			if (v == -1)
+				v = voiceStealer.getQuietest(sounding);
+			if (v == -1)
+				return;
+			voiceStealer.steal(v);
+			sounding[v] = released[v] = settled[v] = false;
+			--numSounding;
+		}
+	}
+
+	void PluginProcessor::triggerNoteOn(double noteNumber, double velocity,
+		int numChannels, int v, bool polyphonic) noexcept
+	{
+		modSources[v][dsp::ModMatrix::kVelocity] = velocity;
+		modSources[v][dsp::ModMatrix::kKey] = noteNumber / 127.;
+		envGensAmp.triggerNoteOn(true, v);
+		envGensMod.triggerNoteOn(true, v);
+		modalFilter.triggerNoteOn(xen, noteNumber, numChannels, v, polyphonic);
+		formantFilter.triggerNoteOn(v);
+		combFilter.triggerNoteOn(xen, noteNumber, numChannels, v);
+		lowpass.triggerNoteOn(xen, noteNumber, numChannels, v);
+	}
+
+	void PluginProcessor::silence(int v) noexcept
+	{
+		envGensAmp.silence(v);
+		envGensMod.silence(v);
+		modalFilter.silence(v);
+		formantFilter.silence(v);
+		combFilter.silence(v);
+		lowpass.silence(v);
+		voiceStealer.reset(v);
+	}
+
+	void PluginProcessor::silence() noexcept
+	{
+		for (auto v = 0; v < dsp::NumMPEChannels; ++v)
+		{
+			silence(v);
+			pendingNoteOns[v].noteNumber = -1.;
+		}
+	}
+
+	double PluginProcessor::synthesizeMod(int modType, int v, int start, int numSamples) noexcept
+	{
+		if (numSamples == 0)
+			return modVals[v];
+
+		modVals[v] = advanceMod(modType, v, start, numSamples);
+		return modVals[v];
+	}
+
+	double PluginProcessor::advanceMod(int modType, int v, int start, int numSamples) noexcept
+	{
+		const auto last = start + numSamples - 1;
+		switch (modType)
+		{
+		case kEnvGen:
+			return envGensMod.advance(v, numSamples);
+		case kEnvMod:
+			return envFolMod.isSleepy() ? 0. : envFolMod[last];
+		case kRandMod:
+			return randMod[last];
+		default:
+			return 0.;
+		}
+	}
+
+	void PluginProcessor::updateModSources(int modSelect, int v, int start, int numSamples) noexcept
+	{
+		if (numSamples == 0)
+			return;
+
+		auto& sources = modSources[v];
+		for (auto m = 0; m < kNumModulators; ++m)
+		{
+			const auto src = static_cast<dsp::ModMatrix::Source>(m);
+			// the selected modulator already advanced over this segment
+			if (m == modSelect)
+				sources[src] = modVals[v];
+			else if (modMatrix.uses(src))
+				sources[src] = advanceMod(m, v, start, numSamples);
+		}
+	}
+
+	double PluginProcessor::getModulated(PID pID, double offset, bool denorm) const noexcept
+	{
+		const auto norm = std::clamp(static_cast<double>(getSnapshot().getNorm(pID)) + offset, 0., 1.);
+		if (!denorm)
+			return norm;
+		return static_cast<double>(params(pID).range.convertFrom0to1(static_cast<float>(norm)));
+	}
+
+	void PluginProcessor::applyModMatrix(int v, double edo,
+		dsp::modal::Voice::Parameters& modalPrms, dsp::formant::Params& formantPrms,
+		dsp::hnm::Params& combPrms, dsp::hnm::lp::Params& lpPrms) noexcept
+	{
+		dsp::ModMatrix::Offsets offsets;
+		modMatrix(modSources[v], offsets);
+
+		using MP = dsp::modal::kParam;
+		auto& modal = modalPrms.params;
+		for (auto i = 0; i < modMatrix.getNumDests(); ++i)
+		{
+			const auto d = modMatrix.getDest(i);
+			const auto pID = param::ModDests[d];
+			// the same values the block computed for all voices, but offset
+			double* dest = nullptr;
+			auto denorm = true;
+			auto scale = 1.;
+			switch (pID)
+			{
+			case PID::ModalBlend: dest = &modal[MP::kBlend].val; denorm = false; break;
+			case PID::ModalBlendEnv: dest = &modal[MP::kBlend].env; break;
+			case PID::ModalBlendBreite: dest = &modal[MP::kBlend].breite; break;
+			case PID::ModalSpreizung: dest = &modal[MP::kSpreizung].val; break;
+			case PID::ModalSpreizungEnv: dest = &modal[MP::kSpreizung].env; break;
+			case PID::ModalSpreizungBreite: dest = &modal[MP::kSpreizung].breite; break;
+			case PID::ModalHarmonie: dest = &modal[MP::kHarmonie].val; denorm = false; break;
+			case PID::ModalHarmonieEnv: dest = &modal[MP::kHarmonie].env; break;
+			case PID::ModalHarmonieBreite: dest = &modal[MP::kHarmonie].breite; break;
+			case PID::ModalKraft: dest = &modal[MP::kKraft].val; break;
+			case PID::ModalKraftEnv: dest = &modal[MP::kKraft].env; break;
+			case PID::ModalKraftBreite: dest = &modal[MP::kKraft].breite; break;
+			case PID::ModalResonanz: dest = &modal[MP::kReso].val; denorm = false; break;
+			case PID::ModalResonanzEnv: dest = &modal[MP::kReso].env; break;
+			case PID::ModalResonanzBreite: dest = &modal[MP::kReso].breite; break;
+			case PID::FormantPos: dest = &formantPrms.blend.val; denorm = false; break;
+			case PID::FormantPosEnv: dest = &formantPrms.blend.env; break;
+			case PID::FormantPosWidth: dest = &formantPrms.blend.width; break;
+			case PID::FormantQ: dest = &formantPrms.q.val; denorm = false; break;
+			case PID::FormantQEnv: dest = &formantPrms.q.env; break;
+			case PID::FormantQWidth: dest = &formantPrms.q.width; break;
+			case PID::CombUnison: dest = &combPrms.retuneWidth; denorm = false; break;
+			case PID::CombFeedback: dest = &combPrms.fb; break;
+			case PID::CombFeedbackEnv: dest = &combPrms.fbEnv; break;
+			case PID::CombFeedbackWidth: dest = &combPrms.fbWidth; break;
+			case PID::CombChordDepth: dest = &combPrms.chordDepth; break;
+			case PID::Damp: dest = &lpPrms.damp; scale = edo; break;
+			case PID::DampEnv: dest = &lpPrms.dampEnv; scale = edo; break;
+			case PID::DampWidth: dest = &lpPrms.dampWidth; scale = edo; break;
+			default: continue;
+			}
+			*dest = getModulated(pID, offsets[d], denorm) * scale;
+		}
 	}
 
 	void PluginProcessor::processBlockBypassed(double**, dsp::MidiBuffer&, int, int) noexcept
@@ -456,30 +761,27 @@ namespace audio
 	void PluginProcessor::loadPatch(const arch::State& state)
 	{
 		keySelector.loadPatch(state);
+		modMatrix.loadPatch(state, params);
 		for (auto i = 0; i < 2; ++i)
 		{
 			auto& material = modalFilter.getMaterial(i);
 			const auto matStr = "mat" + juce::String(i);
 			material.loadPatch(state, matStr);
-			for (auto k = 0; k < 1000000; ++k)
-				if (material.status.load() == dsp::modal::StatusMat::Processing)
-				{
-					material.reportUpdate();
-					return;
-				}
 		}
 	}
 
-	void PluginProcessor::timerCallback()
+	void PluginProcessor::savePatch(arch::State& state, float* dest)
 	{
-		const auto edtrExists = !editorExists.load();
-		if (edtrExists)
-			return;
+		keySelector.savePatch(state);
 		for (auto i = 0; i < 2; ++i)
-		{
-			auto& material = modalFilter.getMaterial(i);
-			auto& status = material.status;
-			status.store(dsp::modal::StatusMat::Processing);
-		}
+			modalFilter.getMaterial(i).savePatch(&dest[i * dsp::modal::Material::NumFloats]);
+	}
+
+	void PluginProcessor::loadPatch(const arch::State& state, const float* src)
+	{
+		keySelector.loadPatch(state);
+		// loading reports the update, the audio thread picks up both materials at its next block
+		for (auto i = 0; i < 2; ++i)
+			modalFilter.getMaterial(i).loadPatch(&src[i * dsp::modal::Material::NumFloats]);
 	}
 }
\ No newline at end of file
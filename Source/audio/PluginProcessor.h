@@ -11,6 +11,10 @@
 #include "dsp/NoiseSynth.h"
 #include "dsp/EnvelopeFollower.h"
 #include "dsp/Randomizer.h"
+#include "dsp/ModMatrix.h"
+#include "dsp/PolyGovernor.h"
+#include "dsp/VoiceStealer.h"
+#include "dsp/Telemetry.h"
 #include "dsp/hnm/modal/ModalFilter.h"
 #include "dsp/hnm/formant/FormantFilter.h"
 #include "dsp/hnm/HnmLowpass.h"
@@ -21,19 +25,60 @@ namespace audio
 {
 	using Timer = juce::Timer;
 
-	struct PluginProcessor :
+	// what the editor and the patches change. both engines share it, so that neither of them has to know
+	// which one plays the current patch. the timer lets the materials take edits while no editor exists
+	struct SharedState :
 		public Timer
+	{
+		SharedState();
+
+		void timerCallback() override;
+
+		dsp::KeySelector keySelector;
+		dsp::modal::DualMaterial materials;
+		std::atomic<bool> editorExists;
+		std::atomic<int> recording;
+		int recSampleIndex;
+	};
+
+	struct PluginProcessor
 	{
 		using Params = param::Params;
 		using PID = param::PID;
+
+		// in the order of ModSelect and of the mod matrix' first sources
+		enum ModType { kEnvGen, kEnvMod, kRandMod, kNumModulators };
+
+		// a note-on that waits for its voice to fade out, noteNumber is -1 if none
+		struct PendingNoteOn
+		{
+			double noteNumber, velocity;
+		};
 		
-		PluginProcessor(Params&, arch::XenManager&);
+		// params, xen, shared
+		PluginProcessor(Params&, arch::XenManager&, SharedState&);
 
 		// sampleRate
 		void prepare(double);
 
 		// samples, midiBuffer, transport, numChannels, numSamples
 		void operator()(double**, dsp::MidiBuffer&, const dsp::Transport::Info&, int, int) noexcept;
+
+		// plays out the previous patch while the other engine fades in the next one. no more notes
+		// reach the voices, the key selector and the recording are left to the other engine
+		// samples, transport, numChannels, numSamples
+		void playOut(double**, const dsp::Transport::Info&, int, int) noexcept;
+
+		// keeps the current parameters and materials, so that the engine goes on with
+		// the previous patch while the next one is applied
+		void freeze() noexcept;
+
+		// ends everything the engine played and follows the current patch again.
+		// for taking over from the other engine before its output is heard
+		void reset() noexcept;
+
+		// numChannels
+		void triggerXen(int) noexcept;
 		
 		// samples, midiBuffer, numChannels, numSamples
 		void processBlockBypassed(double**, dsp::MidiBuffer&, int, int) noexcept;
@@ -42,23 +87,38 @@ namespace audio
 		
 		void loadPatch(const arch::State&);
 
-		void timerCallback() override;
+		// floats of both materials in the binary state
+		static constexpr int NumFloats = 2 * dsp::modal::Material::NumFloats;
+
+		// state, dest; materials are packed, everything else goes to the state tree
+		void savePatch(arch::State&, float*);
+
+		// state, src
+		void loadPatch(const arch::State&, const float*);
 
 		Params& params;
 		arch::XenManager& xen;
 		double sampleRate;
 
-		dsp::KeySelector keySelector;
+		dsp::KeySelector& keySelector;
 		dsp::MonophonyHandler monophonyHandler;
 		dsp::AutoMPE autoMPE;
 		dsp::MPESplit voiceSplit;
 		dsp::PPMIDIBand parallelProcessor;
+		dsp::PolyGovernor polyGovernor;
+		dsp::VoiceStealer voiceStealer;
+		dsp::AutoMPE::Energies voiceEnergies;
+		std::array<PendingNoteOn, dsp::NumMPEChannels> pendingNoteOns;
 		std::array<std::array<double, dsp::BlockSize>, 2> formantLayer;
 
 		dsp::EnvGenMultiVoice envGensAmp, envGensMod;
+		// the snapshot's versions start at 1, so 0 forces an update after prepare
+		param::ParamSnapshot::Version envGenAmpVersion;
 		dsp::EnvelopeFollower envFolMod;
 		dsp::Randomizer randMod;
-		std::array<std::function<double(int, int, int)>, 3> getModValFuncs;
+		std::array<double, dsp::NumMPEChannels> modVals;
+		dsp::ModMatrix modMatrix;
+		std::array<dsp::ModMatrix::Sources, dsp::NumMPEChannels> modSources;
 
 		dsp::NoiseSynth noiseSynth;
 		dsp::modal::ModalFilter modalFilter;
@@ -66,9 +126,63 @@ namespace audio
 		dsp::hnm::Comb combFilter;
 		dsp::hnm::lp::Filter lowpass;
 
-		std::atomic<bool> editorExists;
+		std::atomic<bool>& editorExists;
+		// the previous patch's parameters while frozen
+		param::ParamSnapshot frozenSnapshot;
+		// stays empty, the engine that plays out gets no more notes
+		dsp::MidiBuffer midiNone;
+		bool frozen;
 
-		std::atomic<int> recording;
-		int recSampleIndex;
+		const param::ParamSnapshot& getSnapshot() const noexcept;
+
+		// samples, midiBuffer, transport, numChannels, numSamples, live
+		void process(double**, dsp::MidiBuffer&, const dsp::Transport::Info&, int, int, bool) noexcept;
+
+		// advances the selected modulator over voice v's event segment and returns its value
+		// at the end of the segment. the stages read it once per segment, formant, comb and lowpass
+		// smooth it with their one-pole PRMs, modal steps to it
+		// modType, v, start, numSamples
+		double synthesizeMod(int, int, int, int) noexcept;
+
+		// advances a modulator over voice v's event segment and returns its value at the end
+		// modType, v, start, numSamples
+		double advanceMod(int, int, int, int) noexcept;
+
+		// reads the modulators the mod matrix routes into voice v's sources
+		// modSelect, v, start, numSamples
+		void updateModSources(int, int, int, int) noexcept;
+
+		// true if no voice rings and nothing waits to be processed
+		bool isSleepy() const noexcept;
+
+		// fills in what the editor visualizes, everything but the cpu load
+		// record
+		void report(dsp::Telemetry::Record&) const noexcept;
+
+		// fades out the quietest voices while more voices ring than the governor allows
+		void governVoices() noexcept;
+
+		// noteNumber, velocity, numChannels, v, polyphonic
+		void triggerNoteOn(double, double, int, int, bool) noexcept;
+
+		// ends everything voice v is doing at once
+		// v
+		void silence(int) noexcept;
+
+		// ends everything all voices are doing at once
+		void silence() noexcept;
+
+		// pID, offset (normalized), denorm
+		double getModulated(PID, double, bool) const noexcept;
+
+		// writes voice v's mod matrix destinations into its copies of the stage parameters
+		// v, edo, modalParams, formantParams, combParams, lpParams
+		void applyModMatrix(int, double, dsp::modal::Voice::Parameters&, dsp::formant::Params&,
+			dsp::hnm::Params&, dsp::hnm::lp::Params&) noexcept;
+
+
+		std::atomic<int>& recording;
+		int& recSampleIndex;
+		int polyphony;
 	};
 }
\ No newline at end of file
@@ -16,7 +16,7 @@ namespace dsp
 
 	void EnvelopeFollower::prepare(double Fs) noexcept
 	{
-		meter.store(0.);
+		meter = 0.;
 		sampleRate = Fs;
 		gainPRM.prepare(sampleRate, 4.);
 		smooth.reset();
@@ -53,7 +53,7 @@ namespace dsp
 
 	double EnvelopeFollower::getMeter() const noexcept
 	{
-		return meter.load();
+		return meter;
 	}
 
 	void EnvelopeFollower::copyMid(double** samples, int numChannels, int numSamples) noexcept
@@ -125,6 +125,6 @@ namespace dsp
 	void EnvelopeFollower::processMeter() noexcept
 	{
 		const auto max = *std::max_element(buffer.begin(), buffer.end());
-		meter.store(max);
+		meter = max;
 	}
 }
\ No newline at end of file
@@ -26,7 +26,7 @@ namespace dsp
 
 		double getMeter() const noexcept;
 	private:
-		std::atomic<double> meter;
+		double meter;
 		std::array<double, BlockSize> buffer;
 		const double MinDb;
 		PRMD gainPRM;
@@ -248,45 +248,253 @@ namespace dsp
 
 	EnvGenMultiVoice::EnvGenMultiVoice() :
 		params(),
-		envGens
-		{
-			params, params, params, params, params,
-			params, params, params, params, params,
-			params, params, params, params, params
-		},
-		buffer()
-	{}
+		envs(),
+		phases(),
+		envStarts(),
+		states(),
+		noteOns(),
+		buffer(),
+		MinDb(math::dbToAmp(-60.))
+	{
+		states.fill(State::Release);
+		phases.fill(1.);
+	}
 
 	void EnvGenMultiVoice::prepare(double sampleRate)
 	{
 		params.prepare(sampleRate);
-		for (auto& envGen : envGens)
-			envGen.prepare(sampleRate);
+		envs.fill(0.);
+		phases.fill(1.);
+		envStarts.fill(0.);
+		states.fill(State::Release);
 	}
 
 	bool EnvGenMultiVoice::isSleepy(int vIdx) const noexcept
 	{
-		return envGens[vIdx].isSleepy();
+		return !noteOns[vIdx] && envs[vIdx] < MinDb;
+	}
+
+	bool EnvGenMultiVoice::isNoteOn(int vIdx) const noexcept
+	{
+		return noteOns[vIdx];
+	}
+
+	EnvGenMultiVoice::State EnvGenMultiVoice::getState(int vIdx) const noexcept
+	{
+		return states[vIdx];
+	}
+
+	void EnvGenMultiVoice::silence(int vIdx) noexcept
+	{
+		envs[vIdx] = 0.;
+		phases[vIdx] = 1.;
+		envStarts[vIdx] = 0.;
+		states[vIdx] = State::Release;
+		noteOns[vIdx] = false;
 	}
 
 	EnvGenMultiVoice::Info EnvGenMultiVoice::operator()(const MidiBuffer& midi, int numSamples, int vIdx) noexcept
 	{
 		auto bufferData = buffer.data();
-		auto& envGen = envGens[vIdx];
-		const auto active = envGen(midi, bufferData, numSamples);
-		return { bufferData, active };
+		if (midi.isEmpty() && isSleepy(vIdx))
+			return { bufferData, false };
+
+		auto start = 0;
+		for (const auto it : midi)
+		{
+			const auto msg = it.getMessage();
+			const auto end = it.samplePosition;
+			synthesize<true>(bufferData, start, end, vIdx);
+			start = end;
+			if (msg.isNoteOn())
+				noteOns[vIdx] = true;
+			else if (msg.isNoteOff() || msg.isAllNotesOff())
+				noteOns[vIdx] = false;
+		}
+		synthesize<true>(bufferData, start, numSamples, vIdx);
+		return { bufferData, true };
 	}
 
 	EnvGenMultiVoice::Info EnvGenMultiVoice::operator()(int vIdx, int numSamples) noexcept
 	{
 		auto bufferData = buffer.data();
-		auto& envGen = envGens[vIdx];
-		for (auto s = 0; s < numSamples; ++s)
+		synthesize<true>(bufferData, 0, numSamples, vIdx);
+		return { bufferData, !isSleepy(vIdx) };
+	}
+
+	double EnvGenMultiVoice::advance(int vIdx, int numSamples) noexcept
+	{
+		synthesize<false>(buffer.data(), 0, numSamples, vIdx);
+		return isSleepy(vIdx) ? 0. : envs[vIdx];
+	}
+
+	template<bool Render>
+	void EnvGenMultiVoice::synthesize(double* bufferData, int s, int end, int v) noexcept
+	{
+		// a finished release stays at 0 until the next note on
+		if (!noteOns[v] && states[v] == State::Release && phases[v] >= 1.)
+		{
+			if constexpr (Render)
+				if (s < end)
+					SIMD::fill(&bufferData[s], envs[v], end - s);
+			return;
+		}
+
+		while (s < end)
+		{
+			auto smpls = &bufferData[s];
+			const auto numSamples = end - s;
+			switch (states[v])
+			{
+			case State::Attack: s += processAttack<Render>(smpls, numSamples, v); break;
+			case State::Decay: s += processDecay<Render>(smpls, numSamples, v); break;
+			case State::Sustain: s += processSustain<Render>(smpls, numSamples, v); break;
+			case State::Release:
+			default: s += processRelease<Render>(smpls, numSamples, v); break;
+			}
+		}
+	}
+
+	int EnvGenMultiVoice::getSegmentLength(double phase, double inc, int numSamples) noexcept
+	{
+		const auto length = std::ceil((1. - phase) / inc) - 1.;
+		return static_cast<int>(math::limit(0., static_cast<double>(numSamples), length));
+	}
+
+	template<bool Render>
+	int EnvGenMultiVoice::processAttack(double* smpls, int numSamples, int v) noexcept
+	{
+		if (!noteOns[v])
+		{
+			states[v] = State::Release;
+			envStarts[v] = envs[v];
+			phases[v] = 0.;
+			return 0;
+		}
+
+		const auto inc = params.atk;
+		const auto phase = phases[v];
+		const auto envStart = envStarts[v];
+		const auto n = getSegmentLength(phase, inc, numSamples);
+		const auto attack = [phase, inc, envStart](int s)
+		{
+			const auto x = Pi + (phase + static_cast<double>(s) * inc) * Pi;
+			const auto w = .5 * math::cosApprox(x > Pi ? x - Tau : x) + .5;
+			return envStart + w * (1. - envStart);
+		};
+		if constexpr (Render)
+			for (auto s = 0; s < n; ++s)
+				smpls[s] = attack(s);
+
+		if (n < numSamples)
+		{
+			states[v] = State::Decay;
+			phases[v] = 0.;
+			envs[v] = 1.;
+			return n;
+		}
+		phases[v] = phase + static_cast<double>(n) * inc;
+		envs[v] = attack(n - 1);
+		return n;
+	}
+
+	template<bool Render>
+	int EnvGenMultiVoice::processDecay(double* smpls, int numSamples, int v) noexcept
+	{
+		if (!noteOns[v])
+		{
+			states[v] = State::Release;
+			envStarts[v] = envs[v];
+			phases[v] = 0.;
+			return 0;
+		}
+
+		const auto inc = params.dcy;
+		const auto sus = params.sus;
+		const auto phase = phases[v];
+		const auto n = getSegmentLength(phase, inc, numSamples);
+		const auto decay = [phase, inc, sus](int s)
+		{
+			const auto x = (phase + static_cast<double>(s) * inc) * Pi;
+			const auto w = .5 * math::cosApprox(x) + .5;
+			return sus + w * (1. - sus);
+		};
+		if constexpr (Render)
+			for (auto s = 0; s < n; ++s)
+				smpls[s] = decay(s);
+
+		if (n < numSamples)
+		{
+			states[v] = State::Sustain;
+			envs[v] = sus;
+			return n;
+		}
+		phases[v] = phase + static_cast<double>(n) * inc;
+		envs[v] = decay(n - 1);
+		return n;
+	}
+
+	template<bool Render>
+	int EnvGenMultiVoice::processSustain(double* smpls, int numSamples, int v) noexcept
+	{
+		if (!noteOns[v])
+		{
+			states[v] = State::Release;
+			envStarts[v] = envs[v];
+			phases[v] = 0.;
+			return 0;
+		}
+
+		const auto sus = params.sus;
+		if constexpr (Render)
+			SIMD::fill(smpls, sus, numSamples);
+		envs[v] = sus;
+		return numSamples;
+	}
+
+	template<bool Render>
+	int EnvGenMultiVoice::processRelease(double* smpls, int numSamples, int v) noexcept
+	{
+		if (noteOns[v])
+		{
+			states[v] = State::Attack;
+			envStarts[v] = envs[v];
+			phases[v] = 0.;
+			return 0;
+		}
+
+		const auto phase = phases[v];
+		if (phase >= 1.)
+		{
+			if constexpr (Render)
+				SIMD::fill(smpls, envs[v], numSamples);
+			return numSamples;
+		}
+
+		const auto inc = params.rls;
+		const auto envStart = envStarts[v];
+		const auto n = getSegmentLength(phase, inc, numSamples);
+		const auto release = [phase, inc, envStart](int s)
+		{
+			const auto x = (phase + static_cast<double>(s) * inc) * Pi;
+			const auto w = .5 * math::cosApprox(x) + .5;
+			return envStart * w;
+		};
+		if constexpr (Render)
+			for (auto s = 0; s < n; ++s)
+				smpls[s] = release(s);
+
+		if (n < numSamples)
 		{
-			const auto env = envGen();
-			bufferData[s] = env;
+			phases[v] = 1.;
+			envs[v] = 0.;
+			if constexpr (Render)
+				SIMD::fill(&smpls[n], 0., numSamples - n);
+			return numSamples;
 		}
-		return { bufferData, !envGen.isSleepy() };
+		phases[v] = phase + static_cast<double>(n) * inc;
+		envs[v] = release(n - 1);
+		return n;
 	}
 
 	bool EnvGenMultiVoice::processGain(double** samplesOut, const double** samplesIn,
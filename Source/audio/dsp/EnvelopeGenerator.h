@@ -72,8 +72,13 @@ namespace dsp
 		int synthesizeEnvelope(double*, int, int) noexcept;
 	};
 
+	// the envelope generators of all voices, with their states stored as arrays.
+	// instead of stepping a state machine per sample it writes the closed-form
+	// curve of each segment in one loop, from one state transition to the next.
 	struct EnvGenMultiVoice
 	{
+		using State = EnvelopeGenerator::State;
+
 		struct Info
 		{
 			double operator[](int i) const noexcept;
@@ -104,11 +109,26 @@ namespace dsp
 		// vIdx, numSamples
 		Info operator()(int, int) noexcept;
 
+		// moves the envelope on like operator() but only computes the value of the last sample.
+		// for modulation that is read once per segment. returns 0 if the envelope sleeps
+		// vIdx, numSamples
+		double advance(int, int) noexcept;
+
 		void triggerNoteOn(bool e, int vIdx) noexcept
 		{
-			envGens[vIdx].noteOn = e;
+			noteOns[vIdx] = e;
 		}
 
+		// vIdx
+		bool isNoteOn(int) const noexcept;
+
+		// vIdx
+		State getState(int) const noexcept;
+
+		// ends the envelope of a voice immediately
+		// vIdx
+		void silence(int) noexcept;
+
 		void updateParametersMs(const EnvelopeGenerator::Parameters&) noexcept;
 
 		void updateParametersSync(const EnvelopeGenerator::Parameters&, double bpm) noexcept;
@@ -117,7 +137,36 @@ namespace dsp
 
 	protected:
 		EnvelopeGenerator::Parameters params;
-		std::array<EnvelopeGenerator, NumMPEChannels> envGens;
+		std::array<double, NumMPEChannels> envs, phases, envStarts;
+		std::array<State, NumMPEChannels> states;
+		std::array<bool, NumMPEChannels> noteOns;
 		std::array<double, BlockSize> buffer;
+		const double MinDb;
+
+		// without Render only the states and the last value move on, the buffer is not touched
+		// buffer, start, end, vIdx
+		template<bool Render>
+		void synthesize(double*, int, int, int) noexcept;
+
+		// the segments return how many samples they have written
+		// buffer, numSamples, vIdx
+		template<bool Render>
+		int processAttack(double*, int, int) noexcept;
+
+		// buffer, numSamples, vIdx
+		template<bool Render>
+		int processDecay(double*, int, int) noexcept;
+
+		// buffer, numSamples, vIdx
+		template<bool Render>
+		int processSustain(double*, int, int) noexcept;
+
+		// buffer, numSamples, vIdx
+		template<bool Render>
+		int processRelease(double*, int, int) noexcept;
+
+		// phase, inc, numSamples
+		// number of samples before phase reaches 1
+		static int getSegmentLength(double, double, int) noexcept;
 	};
 }
\ No newline at end of file
@@ -7,8 +7,11 @@ namespace dsp
 		requestUpdate(true),
 		actives(),
 		offset(69 - 12),
-		enabled(true)
+		enabled(true),
+		paths()
 	{
+		for (auto i = 0; i < NumKeys; ++i)
+			paths[i] = arch::StatePath("keys/key" + String(i));
 		bool sharps[12] = { false, true, false, false, false, true, true, false, false, false, true, false };
 		for (auto i = 0; i < 12; ++i)
 			keys[i].store(sharps[i]);
@@ -21,8 +24,7 @@ namespace dsp
 		bool e = false;
 		for (auto i = 0; i < NumKeys; ++i)
 		{
-			const auto str = "keys/key" + String(i);
-			const auto var = state.get(str);
+			const auto var = state.get(paths[i]);
 			if (var)
 			{
 				const bool val = static_cast<int>(*var) == 1;
@@ -38,9 +40,8 @@ namespace dsp
 	{
 		for (auto i = 0; i < NumKeys; ++i)
 		{
-			const auto str = "keys/key" + String(i);
 			const auto val = keys[i].load() ? 1 : 0;
-			state.set(str, val);
+			state.set(paths[i], val);
 		}
 	}
 
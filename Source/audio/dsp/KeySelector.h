@@ -36,6 +36,7 @@ namespace dsp
 		std::array<int, NumMPEChannels> actives;
 		int offset;
 		bool enabled;
+		std::array<arch::StatePath, NumKeys> paths;
 
 		// midi, active
 		void generateNoteOff(MidiBuffer&, int);
@@ -0,0 +1,129 @@
+#include "ModMatrix.h"
+
+namespace dsp
+{
+	using PID = param::PID;
+
+	// slotIdx, returns the slot's source parameter, destination and depth follow it
+	static PID toSlotPID(int slotIdx) noexcept
+	{
+		return param::offset(PID::ModSlot1Src, slotIdx * param::NumParamsPerModSlot);
+	}
+
+	ModMatrix::ModMatrix() :
+		srcs(),
+		dests(),
+		destsUsed(),
+		depths(),
+		version(0),
+		numRoutes(0),
+		numDestsUsed(0),
+		sourcesUsed(0),
+		pathsDepth()
+	{
+		for (auto i = 0; i < NumSlots; ++i)
+		{
+			const auto pIDDepth = param::offset(toSlotPID(i), 2);
+			pathsDepth[i] = arch::StatePath("params/" + param::toID(param::toString(pIDDepth)) + "/value");
+		}
+	}
+
+	void ModMatrix::loadPatch(const State& state, Params& params) const
+	{
+		// missing parameters keep their values, but a route of the previous patch would change this one
+		for (auto i = 0; i < NumSlots; ++i)
+		{
+			if (state.get(pathsDepth[i]))
+				continue;
+			auto& depth = params(param::offset(toSlotPID(i), 2));
+			if (!depth.isLocked())
+				depth.setValueNotifyingHost(depth.range.convertTo0to1(0.f));
+		}
+	}
+
+	void ModMatrix::prepare() noexcept
+	{
+		// the snapshot's versions start at 1, so 0 compiles the routes at the next block
+		version = 0;
+	}
+
+	void ModMatrix::compile(const Snapshot& snap) noexcept
+	{
+		Snapshot::Version v = 0;
+		for (auto i = 0; i < NumSlots * param::NumParamsPerModSlot; ++i)
+			v += snap.getVersion(param::offset(PID::ModSlot1Src, i));
+		if (version == v)
+			return;
+		version = v;
+
+		numRoutes = 0;
+		numDestsUsed = 0;
+		sourcesUsed = 0;
+		for (auto i = 0; i < NumSlots; ++i)
+		{
+			const auto pIDSrc = toSlotPID(i);
+			const auto depth = static_cast<double>(snap(param::offset(pIDSrc, 2)));
+			if (depth == 0.)
+				continue;
+			const auto src = juce::jlimit(0, kNumSources - 1, static_cast<int>(std::round(snap(pIDSrc))));
+			const auto dest = juce::jlimit(0, NumDests - 1, static_cast<int>(std::round(snap(param::offset(pIDSrc, 1)))));
+			srcs[numRoutes] = src;
+			dests[numRoutes] = dest;
+			depths[numRoutes] = depth;
+			++numRoutes;
+			sourcesUsed |= 1u << src;
+
+			auto known = false;
+			for (auto d = 0; d < numDestsUsed; ++d)
+				known = known || destsUsed[d] == dest;
+			if (!known)
+			{
+				destsUsed[numDestsUsed] = dest;
+				++numDestsUsed;
+			}
+		}
+	}
+
+	bool ModMatrix::isEmpty() const noexcept
+	{
+		return numRoutes == 0;
+	}
+
+	bool ModMatrix::uses(Source src) const noexcept
+	{
+		return (sourcesUsed & (1u << src)) != 0;
+	}
+
+	int ModMatrix::getNumDests() const noexcept
+	{
+		return numDestsUsed;
+	}
+
+	int ModMatrix::getDest(int i) const noexcept
+	{
+		return destsUsed[i];
+	}
+
+	void ModMatrix::operator()(const Sources& sources, Offsets& offsets) const noexcept
+	{
+		for (auto d = 0; d < numDestsUsed; ++d)
+			offsets[destsUsed[d]] = 0.;
+		for (auto r = 0; r < numRoutes; ++r)
+			offsets[dests[r]] += sources[srcs[r]] * depths[r];
+	}
+
+	String toString(ModMatrix::Source src)
+	{
+		switch (src)
+		{
+		case ModMatrix::kEnvGen: return "Env Gen";
+		case ModMatrix::kEnvFol: return "Env Fol";
+		case ModMatrix::kRand: return "Random";
+		case ModMatrix::kVelocity: return "Velocity";
+		case ModMatrix::kKey: return "Key";
+		case ModMatrix::kPressure: return "Pressure";
+		case ModMatrix::kSlide: return "Slide";
+		default: return "Invalid Source";
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+#include "../Using.h"
+#include "../../param/Param.h"
+
+namespace dsp
+{
+	// routes per-voice modulation sources to the parameters each voice keeps its own copy of.
+	// the slots are host parameters, the audio thread compiles them into a flat list of routes
+	// whenever one of them changed, so evaluating a voice is a single loop without branches.
+	// the modulators are independent sources, ModSelect only picks the one the stages' env depths follow
+	struct ModMatrix
+	{
+		using State = arch::State;
+		using String = arch::String;
+		using Params = param::Params;
+		using Snapshot = param::ParamSnapshot;
+
+		// the modulators come first, in the order of ModSelect
+		enum Source { kEnvGen, kEnvFol, kRand, kVelocity, kKey, kPressure, kSlide, kNumSources };
+		static constexpr int NumSlots = param::NumModSlots;
+		static constexpr int NumDests = param::NumModDests;
+
+		using Sources = std::array<double, kNumSources>;
+		// indexed like param::ModDests
+		using Offsets = std::array<double, NumDests>;
+
+		ModMatrix();
+
+		// state, params; patches from before the matrix existed get no routes
+		void loadPatch(const State&, Params&) const;
+
+		void prepare() noexcept;
+
+		// snapshot, rebuilds the flat route list if a slot changed
+		void compile(const Snapshot&) noexcept;
+
+		// true if no route would change any destination
+		bool isEmpty() const noexcept;
+
+		// src, true if any route reads it
+		bool uses(Source) const noexcept;
+
+		// the destinations the routes write to, each one once
+		int getNumDests() const noexcept;
+
+		// i, returns the index into param::ModDests
+		int getDest(int) const noexcept;
+
+		// sources, offsets (normalized)
+		void operator()(const Sources&, Offsets&) const noexcept;
+	protected:
+		std::array<int, NumSlots> srcs, dests, destsUsed;
+		std::array<double, NumSlots> depths;
+		Snapshot::Version version;
+		int numRoutes, numDestsUsed;
+		uint32_t sourcesUsed;
+		std::array<arch::StatePath, NumSlots> pathsDepth;
+	};
+
+	// src
+	String toString(ModMatrix::Source);
+}
\ No newline at end of file
@@ -61,6 +61,16 @@ namespace dsp
 		smoothing = false;
 	}
 
+	template<typename Float>
+	void PRM<Float>::reset(Float val) noexcept
+	{
+		smooth.reset(val);
+		value = val;
+		smoothing = false;
+		for (auto& b : buf)
+			b = val;
+	}
+
 	template<typename Float>
 	PRMInfo<Float> PRM<Float>::operator()(Float val, int numSamples) noexcept
 	{
@@ -37,6 +37,9 @@ namespace dsp
 		// sampleRate, smoothLenMs
 		void prepare(Float sampleRate, Float smoothLenMs) noexcept;
 
+		// value, jumps there without smoothing
+		void reset(Float) noexcept;
+
 		// value, numSamples
 		PRMInfo<Float> operator()(Float, int) noexcept;
 
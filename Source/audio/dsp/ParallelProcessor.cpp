@@ -1,14 +1,13 @@
 #include "ParallelProcessor.h"
+#include <bit>
 
 namespace dsp
 {
 	template<size_t NumBands>
 	ParallelProcessor<NumBands>::ParallelProcessor() :
 		bands(),
-		sleepy()
+		awake(0)
 	{
-		for (auto& s : sleepy)
-			s = true;
 	}
 
 	template<size_t NumBands>
@@ -40,16 +39,26 @@ namespace dsp
 	template<size_t NumBands>
 	void ParallelProcessor<NumBands>::joinReplace(double* const* samples, int numChannels, int numSamples) noexcept
 	{
+		auto bandsAwake = awake & ((1u << MaxBand) - 1u);
+		if (bandsAwake == 0)
 		{
-			const double* band[] = { bands[0].data(), bands[1].data() };
+			for (auto ch = 0; ch < numChannels; ++ch)
+				SIMD::clear(samples[ch], numSamples);
+			return;
+		}
+
+		{
+			const auto b2 = 2 * std::countr_zero(bandsAwake);
+			const double* band[] = { bands[b2].data(), bands[b2 + 1].data() };
 
 			for (auto ch = 0; ch < numChannels; ++ch)
 				SIMD::copy(samples[ch], band[ch], numSamples);
+			bandsAwake &= bandsAwake - 1u;
 		}
 
-		for (auto b = 1; b < MaxBand; ++b)
+		for (; bandsAwake != 0; bandsAwake &= bandsAwake - 1u)
 		{
-			const auto b2 = 2 * b;
+			const auto b2 = 2 * std::countr_zero(bandsAwake);
 			const double* band[] = { bands[b2].data(), bands[b2 + 1].data() };
 
 			for (auto ch = 0; ch < numChannels; ++ch)
@@ -162,13 +171,22 @@ namespace dsp
 	template<size_t NumBands>
 	bool ParallelProcessor<NumBands>::isSleepy(int idx) const noexcept
 	{
-		return sleepy[idx];
+		return (awake & (1u << idx)) == 0;
 	}
 	
 	template<size_t NumBands>
 	void ParallelProcessor<NumBands>::setSleepy(bool e, int idx) noexcept
 	{
-		sleepy[idx] = e;
+		if (e)
+			awake &= ~(1u << idx);
+		else
+			awake |= 1u << idx;
+	}
+
+	template<size_t NumBands>
+	uint32_t ParallelProcessor<NumBands>::getAwake() const noexcept
+	{
+		return awake;
 	}
 
 	template struct ParallelProcessor<2>;
@@ -8,6 +8,7 @@ namespace dsp
 	{
 		static constexpr int MaxBand = NumBands - 1;
 		static constexpr int NumChannels = 2 * MaxBand;
+		static_assert(NumBands <= 32, "the awake bands must fit into a 32 bit mask");
 
 		struct Band
 		{
@@ -23,6 +24,7 @@ namespace dsp
 		// samples, numChannels, numSamples
 		void join(double* const*, int, int) noexcept;
 
+		// only sums the bands that are awake
 		// samples, numChannels, numSamples
 		void joinReplace(double* const*, int, int) noexcept;
 
@@ -58,9 +60,12 @@ namespace dsp
 		// sleepyState, bandIdx
 		void setSleepy(bool, int) noexcept;
 
+		// bit i is set if band i is awake
+		uint32_t getAwake() const noexcept;
+
 	private:
 		std::array<std::array<double, BlockSize2x>, NumChannels> bands;
-		std::array<bool, NumBands> sleepy;
+		uint32_t awake;
 	};
 
 	using PP2Band = ParallelProcessor<2>;
@@ -0,0 +1,76 @@
+#include "PolyGovernor.h"
+
+namespace dsp
+{
+	PolyGovernor::PolyGovernor() :
+		sampleRateInv(1.),
+		secsPerTick(1. / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond())),
+		load(0.),
+		overloadSecs(0.),
+		headroomSecs(0.),
+		ticksStart(0),
+		voiceLimit(NumMPEChannels),
+		enabled(false)
+	{}
+
+	void PolyGovernor::prepare(double sampleRate) noexcept
+	{
+		sampleRateInv = 1. / sampleRate;
+		load = overloadSecs = headroomSecs = 0.;
+		voiceLimit = NumMPEChannels;
+	}
+
+	void PolyGovernor::begin(bool e) noexcept
+	{
+		enabled = e;
+		if (!enabled)
+		{
+			load = overloadSecs = headroomSecs = 0.;
+			voiceLimit = NumMPEChannels;
+			return;
+		}
+		ticksStart = juce::Time::getHighResolutionTicks();
+	}
+
+	void PolyGovernor::end(int numSamples) noexcept
+	{
+		if (!enabled || numSamples == 0)
+			return;
+		const auto ticks = juce::Time::getHighResolutionTicks() - ticksStart;
+		const auto elapsedSecs = static_cast<double>(ticks) * secsPerTick;
+		const auto budgetSecs = static_cast<double>(numSamples) * sampleRateInv;
+		const auto loadCur = elapsedSecs / budgetSecs;
+		load += std::min(1., budgetSecs / SmoothSecs) * (loadCur - load);
+
+		if (load > OverloadLoad)
+		{
+			headroomSecs = 0.;
+			overloadSecs += budgetSecs;
+			if (overloadSecs < OverloadSecs)
+				return;
+			overloadSecs = 0.;
+			voiceLimit = std::max(1, voiceLimit - 1);
+		}
+		else if (load < HeadroomLoad)
+		{
+			overloadSecs = 0.;
+			headroomSecs += budgetSecs;
+			if (headroomSecs < HeadroomSecs)
+				return;
+			headroomSecs = 0.;
+			voiceLimit = std::min(NumMPEChannels, voiceLimit + 1);
+		}
+		else
+			overloadSecs = headroomSecs = 0.;
+	}
+
+	int PolyGovernor::getVoiceLimit() const noexcept
+	{
+		return voiceLimit;
+	}
+
+	double PolyGovernor::getLoad() const noexcept
+	{
+		return load;
+	}
+}
\ No newline at end of file
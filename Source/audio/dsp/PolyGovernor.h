@@ -0,0 +1,38 @@
+#pragma once
+#include "../Using.h"
+
+namespace dsp
+{
+	// measures which part of the real-time budget the voices take up and lowers
+	// the number of voices that may ring under sustained overload.
+	// once there is headroom again the voices get restored one by one.
+	struct PolyGovernor
+	{
+		static constexpr double SmoothSecs = .05;
+		static constexpr double OverloadLoad = .6;
+		static constexpr double OverloadSecs = .1;
+		static constexpr double HeadroomLoad = .3;
+		static constexpr double HeadroomSecs = 1.;
+
+		PolyGovernor();
+
+		// sampleRate
+		void prepare(double) noexcept;
+
+		// enabled
+		void begin(bool) noexcept;
+
+		// numSamples
+		void end(int) noexcept;
+
+		int getVoiceLimit() const noexcept;
+
+		// smoothed ratio of processing time and real time
+		double getLoad() const noexcept;
+	protected:
+		double sampleRateInv, secsPerTick, load, overloadSecs, headroomSecs;
+		Int64 ticksStart;
+		int voiceLimit;
+		bool enabled;
+	};
+}
\ No newline at end of file
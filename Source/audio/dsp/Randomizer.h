@@ -19,7 +19,7 @@ namespace dsp
 
 		void prepare(double sampleRate) noexcept
 		{
-			meter.store(0.f);
+			meter = 0.f;
 			perlin.prepare(sampleRate);
 		}
 
@@ -37,7 +37,7 @@ namespace dsp
 				params.smooth * params.smooth
 			);
 
-			meter.store(static_cast<float>(buffer[numSamples - 1]));
+			meter = static_cast<float>(buffer[numSamples - 1]);
 		}
 
 		double operator[](int i) const noexcept
@@ -47,10 +47,10 @@ namespace dsp
 
 		float getMeter() const noexcept
 		{
-			return meter.load();
+			return meter;
 		}
 	private:
-		std::atomic<float> meter;
+		float meter;
 		std::array<double, BlockSize> buffer;
 		perlin::Perlin2 perlin;
 	};
@@ -1,119 +1,118 @@
 #include "Resonator.h"
-#include "Distortion.h"
 
 namespace dsp
 {
-	// ResonatorBase
-
-	ResonatorBase::ResonatorBase() :
+	namespace reso
+	{
+		// Direct
+
+		Direct::Direct() :
+			y1(0.), y2(0.),
+			b1(0.), b2(0.)
+		{
+			//g = (1. - b2) * std::sin(w);
+		}
+
+		void Direct::reset() noexcept
+		{
+			y1 = 0.;
+			y2 = 0.;
+		}
+
+		void Direct::update(double fc, double bw) noexcept
+		{
+			const auto w = fc * Tau;
+			const auto r = 1. - std::sin(Pi * bw);
+			b1 = -2. * r * std::cos(w);
+			b2 = r * r;
+		}
+
+		void Direct::copyFrom(const Direct& other) noexcept
+		{
+			b1 = other.b1;
+			b2 = other.b2;
+		}
+
+		// Normalized
+
+		Normalized::Normalized() :
+			b2(0.), b1(0.), a0(0.),
+			z1(0.), z2(0.)
+		{}
+
+		void Normalized::reset() noexcept
+		{
+			z1 = 0.;
+			z2 = 0.;
+		}
+
+		void Normalized::update(double fc, double bw) noexcept
+		{
+			b2 = std::exp(-Tau * bw);
+			const auto fcTau = Tau * fc;
+			const auto b2_4 = 4. * b2;
+			const auto cosFc = std::cos(fcTau);
+			b1 = (-b2_4 / (1. + b2)) * cosFc;
+			const auto sqrtVal = static_cast<float>(1. - b1 * b1 / b2_4);
+			a0 = (1. - b2) * std::sqrt(sqrtVal);
+		}
+
+		void Normalized::copyFrom(const Normalized& other) noexcept
+		{
+			b2 = other.b2;
+			b1 = other.b1;
+			a0 = other.a0;
+		}
+	}
+
+	// Resonator
+
+	template<class Topology, class Saturation>
+	Resonator<Topology, Saturation>::Resonator() :
+		Topology(),
 		fc(0.), bw(0.), gain(1.)
 	{}
 
-	void ResonatorBase::setCutoffFc(double _fc) noexcept
-	{
-		fc = _fc;
-	}
-
-	void ResonatorBase::setBandwidth(double _bw) noexcept
-	{
-		bw = _bw;
-	}
-
-	void ResonatorBase::setGain(double _gain) noexcept
-	{
-		gain = _gain;
-	}
-
-	double ResonatorBase::distort(double y) const noexcept
-	{
-		return ratioclip(y, .8, 1. / 16.);
-	}
-
-	// Resonator1
-	
-	Resonator1::Resonator1() :
-		ResonatorBase(),
-		y1(0.), y2(0.),
-		b1(0.), b2(0.)
-	{
-		//g = (1. - b2) * std::sin(w);
-	}
-
-	void Resonator1::reset() noexcept
+	template<class Topology, class Saturation>
+	void Resonator<Topology, Saturation>::reset() noexcept
 	{
-		y1 = 0.;
-		y2 = 0.;
+		Topology::reset();
 	}
 
-	void Resonator1::update() noexcept
+	template<class Topology, class Saturation>
+	void Resonator<Topology, Saturation>::setCutoffFc(double _fc) noexcept
 	{
-		const auto w = fc * Tau;
-		const auto r = 1. - std::sin(Pi * bw);
-		b1 = -2. * r * std::cos(w);
-		b2 = r * r;
+		fc = _fc;
 	}
 
-	void Resonator1::copyFrom(const Resonator1& other) noexcept
+	template<class Topology, class Saturation>
+	void Resonator<Topology, Saturation>::setBandwidth(double _bw) noexcept
 	{
-		b1 = other.b1;
-		b2 = other.b2;
+		bw = _bw;
 	}
 
-	double Resonator1::operator()(double x0) noexcept
+	template<class Topology, class Saturation>
+	void Resonator<Topology, Saturation>::setGain(double _gain) noexcept
 	{
-		auto y0 =
-			x0
-			- b1 * y1
-			- b2 * y2;
-		y0 = distort(y0);
-		y2 = y1;
-		y1 = y0;
-		return y0 * gain;
-	}
-
-	// Resonator2
-
-	Resonator2::Resonator2() :
-		ResonatorBase(),
-		b2(0.), b1(0.), a0(0.),
-		z1(0.), z2(0.)
-	{}
-
-	void Resonator2::reset() noexcept
-	{
-		z1 = 0.;
-		z2 = 0.;
+		gain = _gain;
 	}
 
-	void Resonator2::update() noexcept
+	template<class Topology, class Saturation>
+	void Resonator<Topology, Saturation>::update() noexcept
 	{
-		b2 = std::exp(-Tau * bw);
-		const auto fcTau = Tau * fc;
-		const auto b2_4 = 4. * b2;
-		const auto cosFc = std::cos(fcTau);
-		b1 = (-b2_4 / (1. + b2)) * cosFc;
-		const auto sqrtVal = static_cast<float>(1. - b1 * b1 / b2_4);
-		a0 = (1. - b2) * std::sqrt(sqrtVal);
+		Topology::update(fc, bw);
 	}
 
-	void Resonator2::copyFrom(const Resonator2& other) noexcept
+	template<class Topology, class Saturation>
+	void Resonator<Topology, Saturation>::copyFrom(const Resonator& other) noexcept
 	{
-		b2 = other.b2;
-		b1 = other.b1;
-		a0 = other.a0;
+		Topology::copyFrom(other);
 	}
 
-	double Resonator2::operator()(double x) noexcept
-	{
-		auto y =
-			a0 * x
-			- b1 * z1
-			- b2 * z2;
-		y = distort(y);
-		z2 = z1;
-		z1 = y;
-		return y * gain;
-	}
+	template struct Resonator<reso::Direct, reso::Linear>;
+	template struct Resonator<reso::Direct, reso::RatioClip>;
+	template struct Resonator<reso::Normalized, reso::Linear>;
+	template struct Resonator<reso::Normalized, reso::RatioClip>;
 
 	// ResonatorStereo
 
@@ -173,12 +172,6 @@ namespace dsp
 		resonators[1].copyFrom(resonators[0]);
 	}
 
-	template<class ResoClass>
-	double ResonatorStereo<ResoClass>::operator()(double x, int ch) noexcept
-	{
-		return resonators[ch](x);
-	}
-
 	template struct ResonatorStereo<Resonator1>;
 	template struct ResonatorStereo<Resonator2>;
 }
\ No newline at end of file
@@ -3,11 +3,105 @@
 
 namespace dsp
 {
-	struct ResonatorBase
+	// compile-time policies of the resonators.
+	// nothing in here is virtual, so that per-sample calls inline into the banks' loops
+	namespace reso
 	{
-		ResonatorBase();
-		
-		virtual void reset() noexcept = 0;
+		// purely linear output
+		struct Linear
+		{
+			static double apply(double y) noexcept
+			{
+				return y;
+			}
+		};
+
+		// same curve as ratioclip(y, .8, 1. / 16.), keeps runaway resonances in check
+		struct RatioClip
+		{
+			static constexpr double Threshold = .8;
+			static constexpr double RatioInv = 1. / 16.;
+
+			static double apply(double y) noexcept
+			{
+				return y < Threshold ? y : RatioInv * (y - Threshold) + Threshold;
+			}
+		};
+
+		//////////////////////////////////////////////////////////////////
+		// A digital resonator is a recursive (IIR) linear system having a complex conjugate pair of
+		// poles located inside the unit circle of the z-plane.
+		// The angle of the poles in polar co-ordinates sets the resonant frequency of the resonator,
+		// while the distance of the poles are to the unit circle sets the bandwidth.
+		// The closer they are to the unit circle, the smaller the bandwidth.
+		// https://www.phon.ucl.ac.uk/courses/spsci/dsp/resoncon.html
+		// personal note: incredibly resonant lowpass filter, maybe useful pre-distortion
+		struct Direct
+		{
+			Direct();
+
+			void reset() noexcept;
+
+			// fc [0, .5], bw [0, .5]
+			void update(double, double) noexcept;
+
+			void copyFrom(const Direct&) noexcept;
+
+			template<class Saturation>
+			double tick(double x0) noexcept
+			{
+				auto y0 =
+					x0
+					- b1 * y1
+					- b2 * y2;
+				y0 = Saturation::apply(y0);
+				y2 = y1;
+				y1 = y0;
+				return y0;
+			}
+
+		protected:
+			double y1, y2;
+			double b1, b2;
+		};
+
+		// https://github.com/julianksdj/Resonator2pole/tree/main
+		struct Normalized
+		{
+			Normalized();
+
+			void reset() noexcept;
+
+			// fc [0, .5], bw [0, .5]
+			void update(double, double) noexcept;
+
+			void copyFrom(const Normalized&) noexcept;
+
+			template<class Saturation>
+			double tick(double x) noexcept
+			{
+				auto y =
+					a0 * x
+					- b1 * z1
+					- b2 * z2;
+				y = Saturation::apply(y);
+				z2 = z1;
+				z1 = y;
+				return y;
+			}
+
+			double b2, b1, a0;
+			double z1, z2;
+		};
+	}
+
+	template<class Topology, class Saturation>
+	struct Resonator :
+		public Topology
+	{
+		Resonator();
+
+		void reset() noexcept;
 
 		// fc [0, .5]
 		void setCutoffFc(double) noexcept;
@@ -18,58 +112,27 @@ namespace dsp
 		// gain [0, 1]
 		void setGain(double) noexcept;
 
-		virtual void update() noexcept = 0;
-
-		virtual double operator()(double) noexcept = 0;
-
-		double fc, bw, gain;
-	protected:
-		double distort(double y) const noexcept;
-	};
-
-	//////////////////////////////////////////////////////////////////
-	// A digital resonator is a recursive (IIR) linear system having a complex conjugate pair of
-	// poles located inside the unit circle of the z-plane.
-	// The angle of the poles in polar co-ordinates sets the resonant frequency of the resonator,
-	// while the distance of the poles are to the unit circle sets the bandwidth.
-	// The closer they are to the unit circle, the smaller the bandwidth.
-	// https://www.phon.ucl.ac.uk/courses/spsci/dsp/resoncon.html
-	// personal note: incredibly resonant lowpass filter, maybe useful pre-distortion
-	struct Resonator1 :
-		public ResonatorBase
-	{
-		Resonator1();
-
-		void reset() noexcept override;
+		void update() noexcept;
 
-		void update() noexcept override;
+		void copyFrom(const Resonator&) noexcept;
 
-		void copyFrom(const Resonator1&) noexcept;
+		double operator()(double x) noexcept
+		{
+			return this->template tick<Saturation>(x) * gain;
+		}
 
-		double operator()(double) noexcept override;
+		// x, y, numSamples (x and y may alias)
+		void process(const double* x, double* y, int numSamples) noexcept
+		{
+			for (auto s = 0; s < numSamples; ++s)
+				y[s] = operator()(x[s]);
+		}
 
-	protected:
-		double y1, y2;
-		double b1, b2;
+		double fc, bw, gain;
 	};
 
-	// https://github.com/julianksdj/Resonator2pole/tree/main
-	struct Resonator2 :
-		public ResonatorBase
-	{
-		Resonator2();
-
-		void reset() noexcept override;
-
-		void update() noexcept override;
-
-		void copyFrom(const Resonator2&) noexcept;
-
-		double operator()(double) noexcept override;
-
-		double b2, b1, a0;
-		double z1, z2;
-	};
+	using Resonator1 = Resonator<reso::Direct, reso::RatioClip>;
+	using Resonator2 = Resonator<reso::Normalized, reso::RatioClip>;
 
 	template<class ResoClass>
 	struct ResonatorStereo
@@ -99,7 +162,16 @@ namespace dsp
 		void update() noexcept;
 
 		// smpl, ch
-		double operator()(double, int) noexcept;
+		double operator()(double x, int ch) noexcept
+		{
+			return resonators[ch](x);
+		}
+
+		// x, y, numSamples, ch
+		void process(const double* x, double* y, int numSamples, int ch) noexcept
+		{
+			resonators[ch].process(x, y, numSamples);
+		}
 
 	protected:
 		std::array<ResoClass, 2> resonators;
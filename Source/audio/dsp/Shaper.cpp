@@ -0,0 +1,100 @@
+#include "Shaper.h"
+#include "Distortion.h"
+
+namespace dsp
+{
+	// ShaperTable
+
+	ShaperTable::ShaperTable(const Func& func, double _xMin, double _xMax, int size) :
+		table(size + 2, 0.),
+		xMin(_xMin),
+		scale(static_cast<double>(size) / (_xMax - _xMin)),
+		idxMax(static_cast<double>(size))
+	{
+		const auto inc = (_xMax - _xMin) / static_cast<double>(size);
+		for (auto i = 0; i <= size; ++i)
+			table[i] = func(xMin + inc * static_cast<double>(i));
+		// guard point, so that idxMax can be interpolated too
+		table[size + 1] = table[size];
+	}
+
+	void ShaperTable::operator()(double* smpls, int numSamples) const noexcept
+	{
+		for (auto s = 0; s < numSamples; ++s)
+			smpls[s] = operator()(smpls[s]);
+	}
+
+	namespace shaper
+	{
+		static constexpr double TanhRange = 8.;
+		// beyond this the softclipper falls back to the exact curve
+		static constexpr double SoftclipRange = 16.;
+		static constexpr double SoftclipKnee = .5 / Pi;
+
+		static int getTableSize(ShaperAccuracy accuracy) noexcept
+		{
+			switch (accuracy)
+			{
+			case ShaperAccuracy::Low: return 1 << 10;
+			case ShaperAccuracy::High: return 1 << 13;
+			default: return 1 << 10;
+			}
+		}
+
+		const ShaperTable& tanh(ShaperAccuracy accuracy)
+		{
+			static const ShaperTable low([](double x) { return std::tanh(x); },
+				-TanhRange, TanhRange, getTableSize(ShaperAccuracy::Low));
+			static const ShaperTable high([](double x) { return std::tanh(x); },
+				-TanhRange, TanhRange, getTableSize(ShaperAccuracy::High));
+			return accuracy == ShaperAccuracy::High ? high : low;
+		}
+
+		const ShaperTable& sinHalfPi(ShaperAccuracy accuracy)
+		{
+			static const ShaperTable low([](double x) { return std::sin(x * PiHalf); },
+				-1., 1., getTableSize(ShaperAccuracy::Low));
+			static const ShaperTable high([](double x) { return std::sin(x * PiHalf); },
+				-1., 1., getTableSize(ShaperAccuracy::High));
+			return accuracy == ShaperAccuracy::High ? high : low;
+		}
+
+		// indexed by sqrt(|x|), because the curve is a power < 1 with a vertical slope at 0
+		static const ShaperTable& softclipTable(ShaperAccuracy accuracy)
+		{
+			const auto func = [](double u)
+			{
+				return softclipPrismaHeavy(u * u, 1., SoftclipKnee);
+			};
+			const auto uMax = std::sqrt(SoftclipRange);
+			static const ShaperTable low(func, 0., uMax, getTableSize(ShaperAccuracy::Low));
+			static const ShaperTable high(func, 0., uMax, getTableSize(ShaperAccuracy::High));
+			return accuracy == ShaperAccuracy::High ? high : low;
+		}
+
+		void softclip(double* smpls, int numSamples, ShaperAccuracy accuracy) noexcept
+		{
+			const auto& table = softclipTable(accuracy);
+			for (auto s = 0; s < numSamples; ++s)
+			{
+				const auto x = smpls[s];
+				const auto xAbs = std::abs(x);
+				const auto y = xAbs < SoftclipRange ?
+					table(std::sqrt(xAbs)) :
+					softclipPrismaHeavy(xAbs, 1., SoftclipKnee);
+				smpls[s] = x < 0. ? -y : y;
+			}
+		}
+
+		void init()
+		{
+			for (auto a = 0; a < static_cast<int>(ShaperAccuracy::NumAccuracies); ++a)
+			{
+				const auto accuracy = static_cast<ShaperAccuracy>(a);
+				tanh(accuracy);
+				sinHalfPi(accuracy);
+				softclipTable(accuracy);
+			}
+		}
+	}
+}
\ No newline at end of file
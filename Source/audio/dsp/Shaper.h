@@ -0,0 +1,57 @@
+#pragma once
+#include "../Using.h"
+#include <functional>
+#include <vector>
+
+namespace dsp
+{
+	enum class ShaperAccuracy { Low, High, NumAccuracies };
+
+	// lookup table of a function on [xMin, xMax] with linear interpolation.
+	// inputs outside of the range are clamped to its edges.
+	// tables are immutable after construction, so they can be shared freely.
+	class ShaperTable
+	{
+	public:
+		using Func = std::function<double(double)>;
+
+		// func, xMin, xMax, size
+		ShaperTable(const Func&, double, double, int);
+
+		// x
+		double operator()(double x) const noexcept
+		{
+			const auto idx = math::limit(0., idxMax, (x - xMin) * scale);
+			const auto i = static_cast<int>(idx);
+			const auto frac = idx - static_cast<double>(i);
+			const auto a = table[i];
+			return a + frac * (table[i + 1] - a);
+		}
+
+		// samples, numSamples
+		void operator()(double*, int) const noexcept;
+	private:
+		std::vector<double> table;
+		double xMin, scale, idxMax;
+	};
+
+	namespace shaper
+	{
+		// the tables are built on first use and shared by all voices and plugin instances
+
+		// builds all tables ahead of time, so that the audio thread never has to
+		void init();
+
+		// tanh(x) on [-8, 8], saturates beyond
+		// accuracy
+		const ShaperTable& tanh(ShaperAccuracy);
+
+		// sin(x * PiHalf) on [-1, 1]
+		// accuracy
+		const ShaperTable& sinHalfPi(ShaperAccuracy);
+
+		// the output softclipper: softclipPrismaHeavy with ceiling 1 and knee .5 / Pi
+		// samples, numSamples, accuracy
+		void softclip(double*, int, ShaperAccuracy) noexcept;
+	}
+}
\ No newline at end of file
@@ -55,6 +55,13 @@ namespace dsp
 				ringing = true;
 			}
 
+			void sleep() noexcept
+			{
+				sample.prepare();
+				timerIndex = 0;
+				ringing = false;
+			}
+
 			void operator()(double* smpls, int start, int end) noexcept
 			{
 				if (!ringing)
@@ -111,6 +118,14 @@ namespace dsp
 			noteOn = false;
 		}
 
+		// for voices that got silenced from the outside
+		void sleep() noexcept
+		{
+			noteOn = false;
+			for (auto& d : detectors)
+				d.sleep();
+		}
+
 		void operator()(double** samples, int numChannels, int start, int end) noexcept
 		{
 			if (noteOn)
@@ -193,6 +193,16 @@ namespace dsp
 		{
 		}
 
+		template<typename Float>
+		void Smooth<Float>::reset(Float val) noexcept
+		{
+			block.curVal = val;
+			lowpass.reset(val);
+			cur = val;
+			dest = val;
+			smoothing = false;
+		}
+
 		template<typename Float>
 		bool Smooth<Float>::operator()(Float* bufferOut, Float _dest, int numSamples) noexcept
 		{
@@ -90,6 +90,9 @@ namespace dsp
 			// startVal
 			Smooth(Float = static_cast<Float>(0));
 
+			// value, jumps there without smoothing
+			void reset(Float) noexcept;
+
 			void operator=(Smooth<Float>& other) noexcept
 			{
 				block.curVal = other.block.curVal;
@@ -0,0 +1,111 @@
+#include "Telemetry.h"
+
+namespace dsp
+{
+	// Record
+
+	Telemetry::Record::Record() :
+		voiceLevels(),
+		modVals(),
+		envGenAmpStates(),
+		envGenModStates(),
+		voicesActive(0),
+		polyphony(NumMPEChannels),
+		envFolMod(0.f),
+		randMod(0.f),
+		partialEnergies(),
+		fundamentalHz(0.f),
+		cpu(0.f),
+		scopeRate(1.f)
+	{
+		envGenAmpStates.fill(State::Release);
+		envGenModStates.fill(State::Release);
+	}
+
+	// Telemetry
+
+	Telemetry::Telemetry() :
+		fifo(Capacity),
+		records(),
+		scopeFifo(ScopeCapacity),
+		scopeBuffer(ScopeCapacity, 0.f),
+		scopeSum(0.),
+		scopeDecimation(1),
+		scopeCount(0),
+		scopeRate(1.f)
+	{}
+
+	void Telemetry::prepare(double sampleRate) noexcept
+	{
+		scopeDecimation = std::max(1, static_cast<int>(sampleRate / ScopeRateMin));
+		scopeRate = static_cast<float>(sampleRate / static_cast<double>(scopeDecimation));
+		scopeSum = 0.;
+		scopeCount = 0;
+	}
+
+	void Telemetry::push(const Record& record) noexcept
+	{
+		const auto scope = fifo.write(1);
+		if (scope.blockSize1 > 0)
+			records[scope.startIndex1] = record;
+		else if (scope.blockSize2 > 0)
+			records[scope.startIndex2] = record;
+	}
+
+	bool Telemetry::pull(Record& dest) noexcept
+	{
+		const auto numReady = fifo.getNumReady();
+		if (numReady == 0)
+			return false;
+		const auto scope = fifo.read(numReady);
+		if (scope.blockSize2 > 0)
+			dest = records[scope.startIndex2 + scope.blockSize2 - 1];
+		else
+			dest = records[scope.startIndex1 + scope.blockSize1 - 1];
+		return true;
+	}
+
+	void Telemetry::pushScope(double* const* samples, int numChannels, int numSamples) noexcept
+	{
+		const auto numOut = (scopeCount + numSamples) / scopeDecimation;
+		const auto scope = scopeFifo.write(numOut);
+		const auto gain = 1. / static_cast<double>(numChannels * scopeDecimation);
+		auto o = 0;
+		for (auto s = 0; s < numSamples; ++s)
+		{
+			for (auto ch = 0; ch < numChannels; ++ch)
+				scopeSum += samples[ch][s];
+			if (++scopeCount != scopeDecimation)
+				continue;
+			// a boxcar average is a crude lowpass, but good enough for a display
+			const auto y = static_cast<float>(scopeSum * gain);
+			if (o < scope.blockSize1)
+				scopeBuffer[scope.startIndex1 + o] = y;
+			else if (o < scope.blockSize1 + scope.blockSize2)
+				scopeBuffer[scope.startIndex2 + o - scope.blockSize1] = y;
+			++o;
+			scopeSum = 0.;
+			scopeCount = 0;
+		}
+	}
+
+	int Telemetry::pullScope(float* dest, int maxNumSamples) noexcept
+	{
+		const auto scope = scopeFifo.read(scopeFifo.getNumReady());
+		const auto numReady = scope.blockSize1 + scope.blockSize2;
+		const auto numSkipped = std::max(0, numReady - maxNumSamples);
+		for (auto o = numSkipped; o < numReady; ++o)
+		{
+			const auto i = o < scope.blockSize1 ?
+				scope.startIndex1 + o :
+				scope.startIndex2 + o - scope.blockSize1;
+			dest[o - numSkipped] = scopeBuffer[i];
+		}
+		return numReady - numSkipped;
+	}
+
+	float Telemetry::getScopeRate() const noexcept
+	{
+		return scopeRate;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+#include "EnvelopeGenerator.h"
+#include "hnm/modal/Axiom.h"
+
+namespace dsp
+{
+	// the audio thread reports its state to the editor through this ring, once per block.
+	// single producer, single consumer and no locks, so meters never tear and
+	// new visualizations don't need new atomics in the hot path
+	struct Telemetry
+	{
+		static constexpr int Capacity = 32;
+		// the scope ring holds a few frames of the decimated output
+		static constexpr int ScopeCapacity = 1 << 13;
+		// the decimation keeps the scope's rate above this
+		static constexpr double ScopeRateMin = 20000.;
+		using State = EnvelopeGenerator::State;
+
+		struct Record
+		{
+			Record();
+
+			std::array<float, NumMPEChannels> voiceLevels, modVals;
+			std::array<State, NumMPEChannels> envGenAmpStates, envGenModStates;
+			// bit v is set while voice v is awake
+			int voicesActive;
+			int polyphony;
+			float envFolMod, randMod;
+			// mean square of each modal partial, summed over the ringing voices
+			std::array<float, modal::NumPartials> partialEnergies;
+			// fundamental of the loudest ringing voice, 0 if none rings
+			float fundamentalHz;
+			// processing time relative to the length of the block
+			float cpu;
+			// sample rate of the scope
+			float scopeRate;
+		};
+
+		Telemetry();
+
+		// sampleRate
+		void prepare(double) noexcept;
+
+		// audio thread, drops the record if the editor falls behind
+		// record
+		void push(const Record&) noexcept;
+
+		// message thread, returns true if there was a new record
+		// dest, is the newest record afterwards
+		bool pull(Record&) noexcept;
+
+		// audio thread, mixes the output to mono and decimates it into the scope ring
+		// samples, numChannels, numSamples
+		void pushScope(double* const*, int, int) noexcept;
+
+		// message thread, skips what doesn't fit into dest, so dest ends with the newest samples
+		// dest, maxNumSamples, returns the number of samples written
+		int pullScope(float*, int) noexcept;
+
+		float getScopeRate() const noexcept;
+
+	private:
+		juce::AbstractFifo fifo;
+		std::array<Record, Capacity> records;
+		juce::AbstractFifo scopeFifo;
+		std::vector<float> scopeBuffer;
+		double scopeSum;
+		int scopeDecimation, scopeCount;
+		float scopeRate;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "VoiceStealer.h"
+
+namespace dsp
+{
+	VoiceStealer::VoiceStealer() :
+		energies(),
+		fades(),
+		fadeIncs(),
+		stealing(),
+		smoothMsInv(1. / SmoothMs),
+		sampleRate(1.),
+		sampleRateInv(1.)
+	{
+		fades.fill(1.);
+	}
+
+	void VoiceStealer::prepare(double _sampleRate) noexcept
+	{
+		sampleRate = _sampleRate;
+		sampleRateInv = 1. / sampleRate;
+		for (auto v = 0; v < NumMPEChannels; ++v)
+			reset(v);
+	}
+
+	void VoiceStealer::measure(const double* const* samples, int numChannels, int numSamples, int v) noexcept
+	{
+		if (numSamples == 0)
+			return;
+		auto sum = 0.;
+		for (auto ch = 0; ch < numChannels; ++ch)
+		{
+			const auto smpls = samples[ch];
+			for (auto s = 0; s < numSamples; ++s)
+				sum += smpls[s] * smpls[s];
+		}
+		const auto meanSquare = sum / static_cast<double>(numChannels * numSamples);
+		const auto segmentMs = static_cast<double>(numSamples) * sampleRateInv * 1000.;
+		const auto coef = std::min(1., segmentMs * smoothMsInv);
+		auto& energy = energies[v];
+		energy += coef * (meanSquare - energy);
+	}
+
+	double VoiceStealer::getEnergy(int v) const noexcept
+	{
+		return energies[v];
+	}
+
+	bool VoiceStealer::isAudible(int v) const noexcept
+	{
+		return energies[v] > InaudibleEnergy;
+	}
+
+	int VoiceStealer::getQuietest(const std::array<bool, NumMPEChannels>& candidates) const noexcept
+	{
+		auto quietest = -1;
+		auto energyMin = std::numeric_limits<double>::max();
+		for (auto v = 0; v < NumMPEChannels; ++v)
+			if (candidates[v] && !stealing[v] && energies[v] < energyMin)
+			{
+				energyMin = energies[v];
+				quietest = v;
+			}
+		return quietest;
+	}
+
+	void VoiceStealer::steal(int v, double fadeMs) noexcept
+	{
+		fadeIncs[v] = math::msToInc(fadeMs, sampleRate);
+		stealing[v] = true;
+	}
+
+	bool VoiceStealer::isStealing(int v) const noexcept
+	{
+		return stealing[v];
+	}
+
+	bool VoiceStealer::operator()(double** samples, int numChannels, int numSamples, int v) noexcept
+	{
+		auto& fade = fades[v];
+		const auto fadeInc = fadeIncs[v];
+		const auto fadeStart = fade;
+		for (auto ch = 0; ch < numChannels; ++ch)
+		{
+			const auto smpls = samples[ch];
+			fade = fadeStart;
+			for (auto s = 0; s < numSamples; ++s)
+			{
+				fade = std::max(0., fade - fadeInc);
+				smpls[s] *= fade;
+			}
+		}
+		return fade == 0.;
+	}
+
+	void VoiceStealer::reset(int v) noexcept
+	{
+		energies[v] = 0.;
+		fades[v] = 1.;
+		stealing[v] = false;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+#include "../Using.h"
+
+namespace dsp
+{
+	// keeps a smoothed energy estimate of each voice's output and fades out voices
+	// that have to give up their resources, so that the quietest ones can be chosen
+	// and none of them stops with a click.
+	struct VoiceStealer
+	{
+		static constexpr double SmoothMs = 50.;
+		static constexpr double FadeMs = 8.;
+		static constexpr double RetriggerFadeMs = 3.;
+		// mean square below which a tail can be cut without being heard, about -80 dB
+		static constexpr double InaudibleEnergy = 1e-8;
+
+		VoiceStealer();
+
+		// sampleRate
+		void prepare(double) noexcept;
+
+		// samples, numChannels, numSamples, v
+		void measure(const double* const*, int, int, int) noexcept;
+
+		// v
+		double getEnergy(int) const noexcept;
+
+		// v
+		bool isAudible(int) const noexcept;
+
+		// candidates[v] marks the voices that may be chosen, returns -1 if none of them
+		// candidates
+		int getQuietest(const std::array<bool, NumMPEChannels>&) const noexcept;
+
+		// starts fading out voice v
+		// v, fadeMs
+		void steal(int, double = FadeMs) noexcept;
+
+		// v
+		bool isStealing(int) const noexcept;
+
+		// applies the fade of a stolen voice, returns true once it is silent
+		// samples, numChannels, numSamples, v
+		bool operator()(double**, int, int, int) noexcept;
+
+		// v
+		void reset(int) noexcept;
+	protected:
+		std::array<double, NumMPEChannels> energies, fades, fadeIncs;
+		std::array<bool, NumMPEChannels> stealing;
+		double smoothMsInv, sampleRate, sampleRateInv;
+	};
+}
\ No newline at end of file
@@ -13,6 +13,111 @@ namespace dsp
 			{
 			}
 
+			// SVFStereo
+
+			static constexpr double SVFR2 = 2.;
+
+			SVFStereo::SVFStereo() :
+				s1(), s2(),
+				g(), h(),
+				gInc(), hInc(),
+				gEnd(), hEnd(),
+				freqHz{ -1., -1. },
+				piOverFs(0.),
+				freqHzMax(0.)
+			{
+			}
+
+			void SVFStereo::prepare(double sampleRate) noexcept
+			{
+				piOverFs = Pi / sampleRate;
+				freqHzMax = sampleRate * .49;
+				reset();
+			}
+
+			void SVFStereo::reset() noexcept
+			{
+				for (auto ch = 0; ch < 2; ++ch)
+				{
+					s1[ch] = s2[ch] = 0.;
+					gInc[ch] = hInc[ch] = 0.;
+					freqHz[ch] = -1.;
+				}
+			}
+
+			void SVFStereo::setCutoffFreqHz(double _freqHz, int ch, int numSamples) noexcept
+			{
+				_freqHz = math::limit(0., freqHzMax, _freqHz);
+				if (freqHz[ch] == _freqHz)
+				{
+					g[ch] = gEnd[ch];
+					h[ch] = hEnd[ch];
+					gInc[ch] = hInc[ch] = 0.;
+					return;
+				}
+				const auto snap = freqHz[ch] < 0.;
+				freqHz[ch] = _freqHz;
+
+				const auto gE = std::tan(_freqHz * piOverFs);
+				gEnd[ch] = gE;
+				hEnd[ch] = 1. / (1. + SVFR2 * gE + gE * gE);
+				if (snap)
+				{
+					g[ch] = gEnd[ch];
+					h[ch] = hEnd[ch];
+					gInc[ch] = hInc[ch] = 0.;
+					return;
+				}
+				const auto numSamplesInv = 1. / static_cast<double>(numSamples);
+				gInc[ch] = (gEnd[ch] - g[ch]) * numSamplesInv;
+				hInc[ch] = (hEnd[ch] - h[ch]) * numSamplesInv;
+			}
+
+			void SVFStereo::operator()(double** samples, int numChannels, int numSamples) noexcept
+			{
+				if (numChannels == 2)
+					process<2>(samples, numSamples);
+				else
+					process<1>(samples, numSamples);
+			}
+
+			template<int NumChannels>
+			void SVFStereo::process(double** samples, int numSamples) noexcept
+			{
+				// both channels side by side in local state, so that they share the vector lanes
+				double z1[NumChannels], z2[NumChannels], gs[NumChannels], hs[NumChannels];
+				for (auto ch = 0; ch < NumChannels; ++ch)
+				{
+					z1[ch] = s1[ch];
+					z2[ch] = s2[ch];
+					gs[ch] = g[ch];
+					hs[ch] = h[ch];
+				}
+
+				for (auto s = 0; s < numSamples; ++s)
+					for (auto ch = 0; ch < NumChannels; ++ch)
+					{
+						gs[ch] += gInc[ch];
+						hs[ch] += hInc[ch];
+						const auto x = samples[ch][s];
+						const auto yHP = hs[ch] * (x - z1[ch] * (gs[ch] + SVFR2) - z2[ch]);
+						const auto yBP = yHP * gs[ch] + z1[ch];
+						z1[ch] = yHP * gs[ch] + yBP;
+						const auto yLP = yBP * gs[ch] + z2[ch];
+						z2[ch] = yBP * gs[ch] + yLP;
+						samples[ch][s] = yLP;
+					}
+
+				static constexpr double Eps = 1e-15;
+				for (auto ch = 0; ch < NumChannels; ++ch)
+				{
+					s1[ch] = std::abs(z1[ch]) < Eps ? 0. : z1[ch];
+					s2[ch] = std::abs(z2[ch]) < Eps ? 0. : z2[ch];
+					g[ch] = gEnd[ch];
+					h[ch] = hEnd[ch];
+				}
+			}
+
 			// Voice::Val
 
 			Voice::Val::Val() :
@@ -84,42 +189,24 @@ namespace dsp
 				return prms[ch].smoothing;
 			}
 
-			double Voice::Val::operator()(int ch, int s) const noexcept
+			double Voice::Val::getFreqHzEnd(int ch, int numSamples) const noexcept
 			{
-				return prms[ch][s];
+				const auto& prm = prms[ch];
+				return prm.smoothing ? prm[numSamples - 1] : prm.value;
 			}
 
 			// Voice
 
 			Voice::Voice() :
-				updateCutoffFuncs
-			{
-				[&](double v, int ch) { lps[ch].setCutoffFrequency(v); },
-				[](double, int) {}
-			},
-				lps(),
+				svf(),
 				val(),
 				sleepy()
 			{
-				for (auto& lp : lps)
-				{
-					lp.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
-					lp.setResonance(1. / std::sqrt(4.));
-					lp.snapToZero();
-				}
 			}
 
 			void Voice::prepare(double sampleRate) noexcept
 			{
-				juce::dsp::ProcessSpec spec;
-				spec.sampleRate = sampleRate;
-				spec.maximumBlockSize = BlockSize;
-				spec.numChannels = 1;
-				for (auto& lp : lps)
-				{
-					lp.prepare(spec);
-					lp.reset();
-				}
+				svf.prepare(sampleRate);
 				val.prepare(sampleRate);
 				sleepy.prepare(sampleRate);
 			}
@@ -128,6 +215,9 @@ namespace dsp
 				const Params& params, const arch::XenManager& xen,
 				double envGenMod, int numChannels, int numSamples) noexcept
 			{
+				// events at the start of a segment or on the same timestamp leave nothing to ramp over
+				if (numSamples == 0)
+					return;
 				val(xen, params, envGenMod, numChannels, numSamples);
 				process(samples, numChannels, numSamples);
 				sleepy(samples, numChannels, numSamples);
@@ -149,6 +239,12 @@ namespace dsp
 				sleepy.triggerNoteOff();
 			}
 
+			void Voice::silence() noexcept
+			{
+				svf.reset();
+				sleepy.sleep();
+			}
+
 			void Voice::triggerPitchbend(const arch::XenManager& xen, double pb, int numChannels) noexcept
 			{
 				val.updatePitchbend(xen, pb, numChannels);
@@ -162,20 +258,8 @@ namespace dsp
 			void Voice::process(double** samples, int numChannels, int numSamples) noexcept
 			{
 				for (auto ch = 0; ch < numChannels; ++ch)
-				{
-					const auto cutoffIdx = val.isSmoothing(ch) ? 0 : 1;
-					const auto& cutoffFunc = updateCutoffFuncs[cutoffIdx];
-					auto& lp = lps[ch];
-
-					for (auto s = 0; s < numSamples; ++s)
-					{
-						cutoffFunc(val(ch, s), ch);
-						auto smpls = samples[ch];
-						const auto smpl = smpls[s];
-						const auto y = lp.processSample(0, smpl);
-						smpls[s] = y;
-					}
-				}
+					svf.setCutoffFreqHz(val.getFreqHzEnd(ch, numSamples), ch, numSamples);
+				svf(samples, numChannels, numSamples);
 			}
 
 			// Filter
@@ -214,6 +298,11 @@ namespace dsp
 				voices[v].triggerNoteOff();
 			}
 
+			void Filter::silence(int v) noexcept
+			{
+				voices[v].silence();
+			}
+
 			void Filter::triggerPitchbend(const arch::XenManager& xen, double pitchbend, int numChannels, int v) noexcept
 			{
 				voices[v].triggerPitchbend(xen, pitchbend, numChannels);
@@ -2,7 +2,6 @@
 #include "../PRM.h"
 #include "../SleepyDetector.h"
 #include "../../../arch/XenManager.h"
-#include <juce_dsp/juce_dsp.h>
 
 namespace dsp
 {
@@ -18,9 +17,34 @@ namespace dsp
 				double damp, dampEnv, dampWidth;
 			};
 
+			// tpt state variable lowpass with a fixed resonance of .5 for both channels.
+			// the coefficients are computed once per block for its last sample
+			// and ramped linearly across the block.
+			struct SVFStereo
+			{
+				SVFStereo();
+
+				// sampleRate
+				void prepare(double) noexcept;
+
+				void reset() noexcept;
+
+				// freqHz, ch, numSamples
+				void setCutoffFreqHz(double, int, int) noexcept;
+
+				// samples, numChannels, numSamples
+				void operator()(double**, int, int) noexcept;
+			private:
+				std::array<double, 2> s1, s2, g, h, gInc, hInc, gEnd, hEnd, freqHz;
+				double piOverFs, freqHzMax;
+
+				// samples, numSamples
+				template<int NumChannels>
+				void process(double**, int) noexcept;
+			};
+
 			struct Voice
 			{
-				using LP = juce::dsp::StateVariableTPTFilter<double>;
 
 				struct Val
 				{
@@ -48,8 +72,8 @@ namespace dsp
 					// ch
 					bool isSmoothing(int) const noexcept;
 
-					// ch, s
-					double operator()(int, int) const noexcept;
+					// ch, numSamples
+					double getFreqHzEnd(int, int) const noexcept;
 
 				private:
 					double pitch, pitchbend;
@@ -75,13 +99,15 @@ namespace dsp
 
 				void triggerNoteOff() noexcept;
 
+				// clears the voice's state, so that it stops ringing immediately
+				void silence() noexcept;
+
 				// xen, pitchbend, numChannels
 				void triggerPitchbend(const arch::XenManager&, double, int) noexcept;
 
 				bool isRinging() const noexcept;
 			private:
-				std::array<std::function<void(double, int)>, 2> updateCutoffFuncs;
-				std::array<LP, 2> lps;
+				SVFStereo svf;
 				Val val;
 				SleepyDetector sleepy;
 
@@ -110,6 +136,9 @@ namespace dsp
 				// v
 				void triggerNoteOff(int) noexcept;
 
+				// v
+				void silence(int) noexcept;
+
 				// xen, pitchbend, numChannels, v
 				void triggerPitchbend(const arch::XenManager&, double, int, int) noexcept;
 
@@ -13,7 +13,7 @@ namespace dsp
 			pitchNote(0.),
 			pitchParam(-1.),
 			pb(0.),
-			delaySamples(0.)
+			delaySamples()
 		{}
 
 		void Val::reset() noexcept
@@ -22,14 +22,23 @@ namespace dsp
 			pitchNote = -1.;
 			pitchParam = 0.;
 			pb = 0.;
-			delaySamples = 0.;
+			for (auto& d : delaySamples)
+				d = 0.;
 		}
 
-		void Val::updateDelaySamples(const XenManager& xen, double Fs) noexcept
+		void Val::updateDelaySamples(const XenManager& xen, const Chord& chord, double Fs) noexcept
 		{
 			const auto pbRange = xen.getPitchbendRange();
-			freqHz = xen.noteToFreqHzWithWrap(pitchNote + pitchParam + pb * pbRange, LowestFrequencyHz);
-			delaySamples = math::freqHzToSamples(freqHz, Fs);
+			const auto pitch = pitchNote + pitchParam + pb * pbRange;
+			freqHz = xen.noteToFreqHzWithWrap(pitch, LowestFrequencyHz);
+			delaySamples[0] = math::freqHzToSamples(freqHz, Fs);
+			const auto semiToXen = xen.getXen() / 12.;
+			for (auto t = 1; t < MaxTaps; ++t)
+			{
+				const auto tapPitch = pitch + chord.intervals[t] * semiToXen;
+				const auto tapFreqHz = xen.noteToFreqHzWithWrap(tapPitch, LowestFrequencyHz);
+				delaySamples[t] = math::freqHzToSamples(tapFreqHz, Fs);
+			}
 		}
 
 		double foldFc(double x) noexcept
@@ -47,6 +56,7 @@ namespace dsp
 
 		DelayFeedback::DelayFeedback() :
 			ringBuffer(),
+			saturator(shaper::tanh(FeedbackShaperAccuracy)),
 			size(0)
 		{
 		}
@@ -57,24 +67,53 @@ namespace dsp
 			ringBuffer.setSize(2, size, false, true, false);
 		}
 
-		void DelayFeedback::operator()(double** samples, const int* wHead, const double* rHead,
-			const double* fbBuffer, int numSamples, int ch) noexcept
+		void DelayFeedback::reset() noexcept
+		{
+			ringBuffer.clear();
+		}
+
+		void DelayFeedback::operator()(double** samples, const int* wHead, const double* const* rHeads,
+			const double* const* tapGains, const double* fbBuffer, int numTaps, int numSamples, int ch) noexcept
 		{
 			auto ringBuf = ringBuffer.getArrayOfWritePointers();
 
 			auto smpls = samples[ch];
 			auto ring = ringBuf[ch];
 
+			if (numTaps == 1)
+			{
+				const auto rHead = rHeads[0];
+				const auto tapGain = tapGains[0];
+				for (auto s = 0; s < numSamples; ++s)
+				{
+					const auto w = wHead[s];
+					const auto r = rHead[s];
+					const auto fb = fbBuffer[s];
+
+					const auto smplPresent = smpls[s];
+					const auto smplDelayed = math::cubicHermiteSpline(ring, r, size);
+
+					const auto sOut = tapGain[s] * saturator(smplDelayed * fb) + smplPresent;
+					const auto sIn = sOut;
+
+					ring[w] = sIn;
+					smpls[s] = sOut;
+				}
+				return;
+			}
+
+			std::array<double, MaxTaps> taps;
 			for (auto s = 0; s < numSamples; ++s)
 			{
 				const auto w = wHead[s];
-				const auto r = rHead[s];
 				const auto fb = fbBuffer[s];
 
-				const auto smplPresent = smpls[s];
-				const auto smplDelayed = math::cubicHermiteSpline(ring, r, size);
-
-				const auto sOut = math::tanhApprox(smplDelayed * fb) + smplPresent;
+				// all taps read before the shared write head moves on
+				for (auto t = 0; t < numTaps; ++t)
+					taps[t] = math::cubicHermiteSpline(ring, rHeads[t][s], size) * fb;
+				auto sOut = smpls[s];
+				for (auto t = 0; t < numTaps; ++t)
+					sOut += tapGains[t][s] * saturator(taps[t]);
 				const auto sIn = sOut;
 
 				ring[w] = sIn;
@@ -110,14 +149,20 @@ namespace dsp
 
 		Voice::Voice() :
 			wHead(),
-			delayPRMs{ 0.,0. },
+			delayPRMs(),
 			feedbackPRMs{ 0., 0. },
+			tapGainPRMs{ 1., 0., 0., 0. },
 			readHead(),
 			delay(),
 			vals(),
+			chord(toChord(ChordType::Off)),
 			Fs(0.),
+			chordDepth(0.),
 			xenInfo(),
 			sleepy(),
+			fbRemap(shaper::sinHalfPi(FeedbackShaperAccuracy)),
+			chordType(ChordType::Off),
+			numTaps(1),
 			size(0)
 		{
 		}
@@ -125,10 +170,13 @@ namespace dsp
 		void Voice::prepare(double sampleRate)
 		{
 			Fs = sampleRate;
-			for (auto& delayPRM : delayPRMs)
-				delayPRM.prepare(Fs, 3.);
+			for (auto& delayPRMsCh : delayPRMs)
+				for (auto& delayPRM : delayPRMsCh)
+					delayPRM.prepare(Fs, 3.);
 			for (auto& feedbackPRM : feedbackPRMs)
 				feedbackPRM.prepare(sampleRate, 1.);
+			for (auto& tapGainPRM : tapGainPRMs)
+				tapGainPRM.prepare(sampleRate, 20.);
 			const auto sizeD = std::ceil(math::freqHzToSamples(LowestFrequencyHz, Fs));
 			size = static_cast<int>(sizeD);
 			wHead.prepare(size);
@@ -153,29 +201,41 @@ namespace dsp
 		{
 			wHead(numSamples);
 			const auto wHeadData = wHead.data();
+			const double* tapGains[MaxTaps];
+			for (auto t = 0; t < numTaps; ++t)
+				tapGains[t] = tapGainPRMs[t].buf.data();
+
 			for (auto ch = 0; ch < numChannels; ++ch)
 			{
-				auto& delayPRM = delayPRMs[ch];
 				auto& val = vals[ch];
-				auto info = delayPRM(val.delaySamples, numSamples);
-				info.copyToBuffer(numSamples);
+				const double* rHeads[MaxTaps];
+				for (auto t = 0; t < numTaps; ++t)
+				{
+					auto& delayPRM = delayPRMs[ch][t];
+					auto info = delayPRM(val.delaySamples[t], numSamples);
+					info.copyToBuffer(numSamples);
+
+					auto delayBuffer = delayPRM.buf.data();
+
+					readHead
+					(
+						delayBuffer,
+						wHeadData,
+						numSamples
+					);
+					rHeads[t] = delayBuffer;
+				}
 
 				const auto fbBuffer = feedbackPRMs[ch].buf.data();
-				auto delayBuffer = delayPRM.buf.data();
-
-				readHead
-				(
-					delayBuffer,
-					wHeadData,
-					numSamples
-				);
 
 				delay
 				(
 					samples,
 					wHeadData,
-					delayBuffer,
+					rHeads,
+					tapGains,
 					fbBuffer,
+					numTaps,
 					numSamples,
 					ch
 				);
@@ -201,6 +261,12 @@ namespace dsp
 			sleepy.triggerNoteOff();
 		}
 
+		void Voice::silence() noexcept
+		{
+			delay.reset();
+			sleepy.sleep();
+		}
+
 		void Voice::triggerPitchbend(const XenManager& xen, double pitchbend, int numChannels) noexcept
 		{
 			for (auto& val : vals)
@@ -232,8 +298,18 @@ namespace dsp
 					wannaUpdate = true;
 				}
 
+			if (chordType != params.chord)
+			{
+				chordType = params.chord;
+				chord = toChord(chordType);
+				wannaUpdate = true;
+			}
+
 			if(wannaUpdate)
 				updatePitch(xen, numChannels);
+
+			chordDepth = params.chordDepth;
+			updateTapGains(numSamples);
 			
 			const double fbWidths[2] =
 			{
@@ -244,18 +320,43 @@ namespace dsp
 			for (auto ch = 0; ch < numChannels; ++ch)
 			{
 				const auto fbModulated = math::limit(-.99, .99, fbWidths[ch] + envGained);
-				const auto fbRemapped = math::sinApprox(fbModulated * PiHalf);
+				const auto fbRemapped = fbRemap(fbModulated);
 				auto info = feedbackPRMs[ch](fbRemapped, numSamples);
 				info.copyToBuffer(numSamples);
 			}
 		}
 
+		void Voice::updateTapGains(int numSamples) noexcept
+		{
+			// the tap gains always sum up to 1, so the feedback stays bounded
+			const auto numChordTaps = static_cast<double>(chord.numTaps);
+			const auto tapGain = chord.numTaps == 1 ? 0. : chordDepth / numChordTaps;
+			const auto rootGain = 1. - tapGain * (numChordTaps - 1.);
+
+			const auto numTapsPrev = numTaps;
+			numTaps = 1;
+			for (auto t = 0; t < MaxTaps; ++t)
+			{
+				const auto gain = t == 0 ? rootGain : t < chord.numTaps ? tapGain : 0.;
+				auto info = tapGainPRMs[t](gain, numSamples);
+				info.copyToBuffer(numSamples);
+				if (info.smoothing || gain != 0.)
+					numTaps = t + 1;
+			}
+
+			// inactive taps don't run their delay smoothers, so the ones that wake up
+			// snap to their interval instead of gliding from where they were left
+			for (auto t = numTapsPrev; t < numTaps; ++t)
+				for (auto ch = 0; ch < 2; ++ch)
+					delayPRMs[ch][t].reset(vals[ch].delaySamples[t]);
+		}
+
 		void Voice::updatePitch(const XenManager& xenManager, int numChannels) noexcept
 		{
 			for (auto ch = 0; ch < numChannels; ++ch)
 			{
 				auto& val = vals[ch];
-				val.updateDelaySamples(xenManager, Fs);
+				val.updateDelaySamples(xenManager, chord, Fs);
 			}
 		}
 
@@ -299,6 +400,11 @@ namespace dsp
 			voices[v].triggerNoteOff();
 		}
 
+		void Comb::silence(int v) noexcept
+		{
+			voices[v].silence();
+		}
+
 		void Comb::triggerPitchbend(const arch::XenManager& xen, double pitchbend, int numChannels, int v) noexcept
 		{
 			voices[v].triggerPitchbend(xen, pitchbend, numChannels);
@@ -3,12 +3,15 @@
 #include "../../PRM.h"
 #include "../../WHead.h"
 #include "../../SleepyDetector.h"
+#include "../../Shaper.h"
+#include "CombAxiom.h"
 
 namespace dsp
 {
 	namespace hnm
 	{
 		static constexpr double LowestFrequencyHz = 20.;
+		static constexpr auto FeedbackShaperAccuracy = ShaperAccuracy::Low;
 		//
 		static constexpr double PB = 0x3fff;
 		static constexpr double PBInv = 1. / PB;
@@ -16,8 +19,9 @@ namespace dsp
 		
 		struct Params
 		{
-			// retune[-n,n]semi, retuneWidth[-1,1], fb[-1,1], fbEnv[-2,2], fbWidth[-2,2]
-			double retune, retuneWidth, fb, fbEnv, fbWidth;
+			// retune[-n,n]semi, retuneWidth[-1,1], fb[-1,1], fbEnv[-2,2], fbWidth[-2,2], chordDepth[0,1], chord
+			double retune, retuneWidth, fb, fbEnv, fbWidth, chordDepth;
+			ChordType chord;
 		};
 
 		struct Val
@@ -26,10 +30,11 @@ namespace dsp
 
 			void reset() noexcept;
 
-			// xen, Fs
-			void updateDelaySamples(const XenManager&, double) noexcept;
+			// xen, chord, Fs
+			void updateDelaySamples(const XenManager&, const Chord&, double) noexcept;
 
-			double freqHz, pitchNote, pitchParam, pb, delaySamples;
+			double freqHz, pitchNote, pitchParam, pb;
+			std::array<double, MaxTaps> delaySamples;
 		};
 
 		struct DelayFeedback
@@ -39,11 +44,14 @@ namespace dsp
 			// delaySize
 			void prepare(int _size);
 
-			// samples, wHead, rHead, feedbackBuffer, numSamples, ch
-			void operator()(double**, const int*, const double*,
-				const double*, int, int) noexcept;
+			void reset() noexcept;
+
+			// samples, wHead, rHeads, tapGains, feedbackBuffer, numTaps, numSamples, ch
+			void operator()(double**, const int*, const double* const*,
+				const double* const*, const double*, int, int, int) noexcept;
 		private:
 			AudioBuffer ringBuffer;
+			const ShaperTable& saturator;
 			int size;
 		};
 
@@ -79,6 +87,9 @@ namespace dsp
 
 			void triggerNoteOff() noexcept;
 
+			// clears the voice's state, so that it stops ringing immediately
+			void silence() noexcept;
+
 			// xen, pitchbend, numChannels
 			void triggerPitchbend(const XenManager&, double, int) noexcept;
 
@@ -86,19 +97,28 @@ namespace dsp
 
 		private:
 			WHead1x wHead;
-			std::array<PRMD, 2> delayPRMs, feedbackPRMs;
+			std::array<std::array<PRMD, MaxTaps>, 2> delayPRMs;
+			std::array<PRMD, 2> feedbackPRMs;
+			std::array<PRMD, MaxTaps> tapGainPRMs;
 			ReadHead readHead;
 			DelayFeedback delay;
 			std::array<Val, 2> vals;
-			double Fs;
+			Chord chord;
+			double Fs, chordDepth;
 			arch::XenManager::Info xenInfo;
 			SleepyDetector sleepy;
+			const ShaperTable& fbRemap;
+			ChordType chordType;
+			int numTaps;
 		public:
 			int size;
 		private:
 			// xenManager, params, envGenMod, numChannels, numSamples
 			void updateParams(const XenManager&, const Params&, double, int, int) noexcept;
 
+			// numSamples
+			void updateTapGains(int) noexcept;
+
 			// xenManager, numChannels
 			void updatePitch(const XenManager&, int) noexcept;
 
@@ -128,6 +148,9 @@ namespace dsp
 			// v
 			void triggerNoteOff(int) noexcept;
 
+			// v
+			void silence(int) noexcept;
+
 			// xen, pitchbend, numChannels, v
 			void triggerPitchbend(const arch::XenManager&, double, int, int) noexcept;
 
@@ -142,8 +165,6 @@ namespace dsp
 // todo
 // 
 //params
-	//chord type[+5, +7, +12, +17, +19, +24]
-	//chord depth[0, 1]
 	//dry blend[-inf, 0]
 	//wet gain[-inf, 0]
 	//flanger/phaser switch
\ No newline at end of file
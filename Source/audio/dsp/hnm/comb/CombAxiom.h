@@ -0,0 +1,73 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <array>
+
+namespace dsp
+{
+	namespace hnm
+	{
+		using String = juce::String;
+
+		// all taps of a voice read from the same ring buffer and write head
+		static constexpr int MaxTaps = 4;
+
+		enum class ChordType
+		{
+			Off,
+			Fourth,
+			Fifth,
+			Octave,
+			OctaveFourth,
+			OctaveFifth,
+			TwoOctaves,
+			Power,
+			Stack,
+			Unison,
+			NumChordTypes
+		};
+		static constexpr int NumChordTypes = static_cast<int>(ChordType::NumChordTypes);
+
+		inline String toString(ChordType c)
+		{
+			switch (c)
+			{
+			case ChordType::Off: return "Off";
+			case ChordType::Fourth: return "+5";
+			case ChordType::Fifth: return "+7";
+			case ChordType::Octave: return "+12";
+			case ChordType::OctaveFourth: return "+17";
+			case ChordType::OctaveFifth: return "+19";
+			case ChordType::TwoOctaves: return "+24";
+			case ChordType::Power: return "+7 +12";
+			case ChordType::Stack: return "+7 +12 +19";
+			case ChordType::Unison: return "Unison";
+			default: return "Invalid Chord";
+			}
+		}
+
+		struct Chord
+		{
+			// intervals in 12edo semitones relative to the comb's pitch
+			std::array<double, MaxTaps> intervals;
+			int numTaps;
+		};
+
+		inline constexpr Chord toChord(ChordType c) noexcept
+		{
+			switch (c)
+			{
+			case ChordType::Fourth: return { { 0., 5., 0., 0. }, 2 };
+			case ChordType::Fifth: return { { 0., 7., 0., 0. }, 2 };
+			case ChordType::Octave: return { { 0., 12., 0., 0. }, 2 };
+			case ChordType::OctaveFourth: return { { 0., 17., 0., 0. }, 2 };
+			case ChordType::OctaveFifth: return { { 0., 19., 0., 0. }, 2 };
+			case ChordType::TwoOctaves: return { { 0., 24., 0., 0. }, 2 };
+			case ChordType::Power: return { { 0., 7., 12., 0. }, 3 };
+			case ChordType::Stack: return { { 0., 7., 12., 19. }, 4 };
+			case ChordType::Unison: return { { 0., -.13, .11, .24 }, 4 };
+			case ChordType::Off:
+			default: return { { 0., 0., 0., 0. }, 1 };
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "FormantBank.h"
+
+namespace dsp
+{
+	namespace formant
+	{
+		// FormantBank::Channel
+
+		FormantBank::Channel::Channel() :
+			a0(), b1(), b2(), gain(),
+			z1(), z2()
+		{
+			reset();
+		}
+
+		void FormantBank::Channel::reset() noexcept
+		{
+			z1.fill(0.);
+			z2.fill(0.);
+		}
+
+		// FormantBank
+
+		FormantBank::FormantBank() :
+			channels()
+		{
+		}
+
+		void FormantBank::reset() noexcept
+		{
+			for (auto& channel : channels)
+				channel.reset();
+		}
+
+		void FormantBank::setCoefficients(const Coefficients& coefs, int ch) noexcept
+		{
+			auto& channel = channels[ch];
+			for (auto i = 0; i < NumFormants; ++i)
+			{
+				channel.a0[i] = coefs.a0[i];
+				channel.b1[i] = coefs.b1[i];
+				channel.b2[i] = coefs.b2[i];
+				channel.gain[i] = coefs.gain[i];
+			}
+		}
+
+		void FormantBank::operator()(double* smpls, int numSamples, int ch) noexcept
+		{
+			// same saturation as reso::RatioClip
+			static constexpr double Threshold = .8;
+			static constexpr double RatioInv = 1. / 16.;
+
+			auto& channel = channels[ch];
+			// local copies, so that the compiler keeps them in registers across samples
+			alignas(64) Lanes a0 = channel.a0;
+			alignas(64) Lanes b1 = channel.b1;
+			alignas(64) Lanes b2 = channel.b2;
+			alignas(64) Lanes gain = channel.gain;
+			alignas(64) Lanes z1 = channel.z1;
+			alignas(64) Lanes z2 = channel.z2;
+			alignas(64) Lanes y;
+
+			for (auto s = 0; s < numSamples; ++s)
+			{
+				const auto x = smpls[s];
+
+				for (auto i = 0; i < NumLanes; ++i)
+				{
+					auto yi = a0[i] * x - b1[i] * z1[i] - b2[i] * z2[i];
+					yi = yi < Threshold ? yi : RatioInv * (yi - Threshold) + Threshold;
+					z2[i] = z1[i];
+					z1[i] = yi;
+					y[i] = yi * gain[i];
+				}
+
+				auto sum = 0.;
+				for (auto i = 0; i < NumLanes; ++i)
+					sum += y[i];
+				smpls[s] = sum;
+			}
+
+			channel.z1 = z1;
+			channel.z2 = z2;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+#include "../../../Using.h"
+#include "FormantGrid.h"
+
+namespace dsp
+{
+	namespace formant
+	{
+		// the formant resonators of a voice (Resonator2) as a structure of arrays.
+		// the formants are padded to a full vector width, so that all of them
+		// are computed side by side on the same dry input instead of in sequence.
+		class FormantBank
+		{
+			static constexpr int NumLanes = 8;
+			static_assert(NumFormants <= NumLanes);
+
+			using Lanes = std::array<double, NumLanes>;
+
+			struct Channel
+			{
+				Channel();
+
+				void reset() noexcept;
+
+				alignas(64) Lanes a0;
+				alignas(64) Lanes b1;
+				alignas(64) Lanes b2;
+				alignas(64) Lanes gain;
+				alignas(64) Lanes z1;
+				alignas(64) Lanes z2;
+			};
+		public:
+			FormantBank();
+
+			void reset() noexcept;
+
+			// coefficients, ch
+			void setCoefficients(const Coefficients&, int) noexcept;
+
+			// smpls, numSamples, ch
+			void operator()(double*, int, int) noexcept;
+		private:
+			std::array<Channel, 2> channels;
+		};
+	}
+}
\ No newline at end of file
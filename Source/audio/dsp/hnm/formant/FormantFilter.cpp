@@ -54,35 +54,32 @@ namespace dsp
 		// Voice
 
 		Voice::Voice() :
-			vowelStereo(),
 			blendPRMs{ 0., 0. },
 			qPRMs{ 0., 0. },
+			coefs(),
 			resonators(),
 			sleepy()
 		{ }
 
 		void Voice::prepare(double sampleRate) noexcept
 		{
-			for (auto& vowel : vowelStereo)
-				vowel.prepare(sampleRate);
 			for(auto& blend: blendPRMs)
 				blend.prepare(sampleRate, 14.);
 			for (auto& q : qPRMs)
 				q.prepare(sampleRate, 14.);
-			for (auto& resonator : resonators)
-				resonator.reset();
+			resonators.reset();
 			sleepy.prepare(sampleRate);
 		}
 
 		void Voice::operator()(double** samples,
-			const Vowels& vowels, const Params& params, double envGenMod,
+			const FormantGrid& grid, const Params& params, double envGenMod,
 			int numChannels, int numSamples, bool forceUpdate) noexcept
 		{
-			updateParameters(vowels, params, envGenMod, numChannels, forceUpdate);
+			updateParameters(grid, params, envGenMod, numChannels, forceUpdate);
 			resonate(samples, numChannels, numSamples);
 		}
 
-		void Voice::updateParameters(const Vowels& vowels, const Params& params, double envGenMod,
+		void Voice::updateParameters(const FormantGrid& grid, const Params& params, double envGenMod,
 			int numChannels, bool forceUpdate) noexcept
 		{
 			double blendArray[2] =
@@ -114,18 +111,8 @@ namespace dsp
 
 				if (forceUpdate || blendInfo.smoothing || qInfo.smoothing)
 				{
-					auto& vowel = vowelStereo[ch];
-					vowel.blend(vowels[0], vowels[1], blendPRM.info.val);
-					vowel.applyQ(qPRM.info.val);
-					for (auto i = 0; i < NumFormants; ++i)
-					{
-						auto& resonator = resonators[i];
-						const auto& formant = vowel.getFormant(i);
-						resonator.setCutoffFc(formant.fc, ch);
-						resonator.setBandwidth(formant.bwFc, ch);
-						resonator.setGain(formant.gain, ch);
-						resonator.update(ch);
-					}
+					grid(coefs, blendPRM.info.val, qPRM.info.val);
+					resonators.setCoefficients(coefs, ch);
 				}
 			}
 		}
@@ -140,6 +127,12 @@ namespace dsp
 			sleepy.triggerNoteOff();
 		}
 
+		void Voice::silence() noexcept
+		{
+			resonators.reset();
+			sleepy.sleep();
+		}
+
 		bool Voice::isSleepy() const noexcept
 		{
 			return sleepy.isSleepy();
@@ -158,27 +151,32 @@ namespace dsp
 
 		void Voice::resonate(double* smpls, int numSamples, int ch) noexcept
 		{
-			for (auto s = 0; s < numSamples; ++s)
-			{
-				const auto dry = smpls[s];
-				auto y = resonators[0](dry, ch);
-				for (auto i = 1; i < NumFormants; ++i)
-				{
-					auto& resonator = resonators[i];
-					y += resonator(dry, ch);
-				}
-				smpls[s] = y;
-			}
+			resonators(smpls, numSamples, ch);
+		}
+
+		// GridBuilder
+
+		Filter::GridBuilder::GridBuilder() :
+			TimeSliceThread("Formant Grids")
+		{
+			startThread(juce::Thread::Priority::low);
+		}
+
+		Filter::GridBuilder::~GridBuilder()
+		{
+			stopThread(1000);
 		}
 
 		// FormantFilter
 
 		Filter::Filter() :
-			vowels
-			{
-				toVowel(VowelClass::SopranoA),
-				toVowel(VowelClass::SopranoE)
-			},
+			TimeSliceClient(),
+			gridBuilder(),
+			grids(),
+			gridMutex(),
+			gridIdx(0),
+			gridRequest(-1),
+			gridBuilt(false),
 			envGens(),
 			gainPRM(0.),
 			voices(),
@@ -186,12 +184,23 @@ namespace dsp
 			releaseMs(-1.),
 			wannaUpdate(false)
 		{
+			gridBuilder->addTimeSliceClient(this);
+		}
+
+		Filter::~Filter()
+		{
+			gridBuilder->removeTimeSliceClient(this);
 		}
 
 		void Filter::prepare(double sampleRate) noexcept
 		{
-			for (auto& vowel : vowels)
-				vowel.prepare(sampleRate);
+			{
+				const std::lock_guard<std::mutex> lock(gridMutex);
+				gridRequest.store(-1);
+				gridBuilt.store(false);
+				for (auto& grid : grids)
+					grid.prepare(sampleRate);
+			}
 			envGens.prepare(sampleRate);
 			gainPRM.prepare(sampleRate, 7.);
 			for (auto& voice : voices)
@@ -216,23 +225,22 @@ namespace dsp
 			gainPRM(gain);
 			
 			wannaUpdate = false;
-			if (vowels[0].getVowelClass() != vowelClassA)
+			if (gridBuilt.load())
 			{
-				vowels[0] = toVowel(vowelClassA);
-				wannaUpdate = true;
-			}
-			if (vowels[1].getVowelClass() != vowelClassB)
-			{
-				vowels[1] = toVowel(vowelClassB);
+				gridIdx.store(1 - gridIdx.load());
+				gridBuilt.store(false);
 				wannaUpdate = true;
 			}
+			const auto& grid = getGrid();
+			if (grid.getVowelClass(0) != vowelClassA || grid.getVowelClass(1) != vowelClassB)
+				gridRequest.store(static_cast<int>(vowelClassA) * NumVowelClasses + static_cast<int>(vowelClassB));
 		}
 
 		void Filter::operator()(double** samples, const Params& params, double envGenMod,
 			int numChannels, int numSamples, int v) noexcept
 		{
 			auto& voice = voices[v];
-			voice(samples, vowels, params, envGenMod, numChannels, numSamples, wannaUpdate);
+			voice(samples, getGrid(), params, envGenMod, numChannels, numSamples, wannaUpdate);
 			if (envGens.processGain(samples, numChannels, numSamples, v))
 				for (auto ch = 0; ch < numChannels; ++ch)
 					SIMD::multiply(samples[ch], gainPRM.info.val, numSamples);
@@ -253,10 +261,43 @@ namespace dsp
 			envGens.triggerNoteOn(false, v);
 		}
 
+		void Filter::silence(int v) noexcept
+		{
+			voices[v].silence();
+			envGens.silence(v);
+		}
+
 		bool Filter::isRinging(int v) const noexcept
 		{
 			auto& voice = voices[v];
 			return !voice.isSleepy();
 		}
+
+		const FormantGrid& Filter::getGrid() const noexcept
+		{
+			return grids[gridIdx.load()];
+		}
+
+		int Filter::useTimeSlice()
+		{
+			static constexpr int IntervalMs = 5;
+			// the last grid waits for the audio thread to swap it in
+			if (gridBuilt.load())
+				return IntervalMs;
+			const auto request = gridRequest.exchange(-1);
+			if (request == -1)
+				return IntervalMs;
+
+			const std::lock_guard<std::mutex> lock(gridMutex);
+			const auto vowelClassA = static_cast<VowelClass>(request / NumVowelClasses);
+			const auto vowelClassB = static_cast<VowelClass>(request % NumVowelClasses);
+			const auto idx = gridIdx.load();
+			const auto& grid = grids[idx];
+			if (grid.getVowelClass(0) == vowelClassA && grid.getVowelClass(1) == vowelClassB)
+				return IntervalMs;
+			grids[1 - idx].update(vowelClassA, vowelClassB);
+			gridBuilt.store(true);
+			return IntervalMs;
+		}
 	}
 }
\ No newline at end of file
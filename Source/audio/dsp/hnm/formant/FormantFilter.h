@@ -1,10 +1,10 @@
 #pragma once
 #include "../../../../arch/XenManager.h"
-#include "../../Resonator.h"
-#include "FormantAxiom.h"
+#include "FormantBank.h"
 #include "../../PRM.h"
 #include "../../SleepyDetector.h"
 #include "../../EnvelopeGenerator.h"
+#include <mutex>
 
 namespace dsp
 {
@@ -44,36 +44,36 @@ namespace dsp
 			std::array<PRMD, 2> prms;
 		};
 
-		using Vowels = std::array<Vowel, 2>;
-		
 		class Voice
 		{
-			using ResonatorArray = std::array<ResonatorStereo2, NumFormants>;
 		public:
 			Voice();
 
 			// sampleRate
 			void prepare(double) noexcept;
 
-			// samples, vowels, params, envGenMod, numChannels, numSamples, forceUpdate
-			void operator()(double**, const Vowels&, const Params&, double, int, int, bool) noexcept;
+			// samples, grid, params, envGenMod, numChannels, numSamples, forceUpdate
+			void operator()(double**, const FormantGrid&, const Params&, double, int, int, bool) noexcept;
 
 			void triggerNoteOn() noexcept;
 
 			void triggerNoteOff() noexcept;
 
+			// clears the voice's state, so that it stops ringing immediately
+			void silence() noexcept;
+
 			bool isSleepy() const noexcept;
 
 			// samples, numChannels, numSamples
 			void fallAsleepIfTired(double**, int, int) noexcept;
 		private:
-			Vowels vowelStereo;
 			std::array<PRMBlockD, 2> blendPRMs, qPRMs;
-			ResonatorArray resonators;
+			Coefficients coefs;
+			FormantBank resonators;
 			SleepyDetector sleepy;
 
-			// vowels, params, envGenMod, numChannels, forceUpdate
-			void updateParameters(const Vowels&, const Params&, double, int, bool) noexcept;
+			// grid, params, envGenMod, numChannels, forceUpdate
+			void updateParameters(const FormantGrid&, const Params&, double, int, bool) noexcept;
 
 			// samples, numChannels, numSamples
 			void resonate(double**, int, int) noexcept;
@@ -82,10 +82,15 @@ namespace dsp
 			void resonate(double*, int, int) noexcept;
 		};
 
-		struct Filter
+		// a new vowel pair's grid is built on a background thread, while the voices keep
+		// interpolating the old one. the audio thread swaps it in at the next block
+		struct Filter :
+			private juce::TimeSliceClient
 		{
 			Filter();
 
+			~Filter() override;
+
 			// sampleRate
 			void prepare(double) noexcept;
 
@@ -99,14 +104,37 @@ namespace dsp
 
 			void triggerNoteOff(int) noexcept;
 
+			// v
+			void silence(int) noexcept;
+
 			bool isRinging(int) const noexcept;
 		private:
-			Vowels vowels;
+			// one low priority thread builds the grids of all instances
+			struct GridBuilder :
+				public juce::TimeSliceThread
+			{
+				GridBuilder();
+
+				~GridBuilder() override;
+			};
+
+			juce::SharedResourcePointer<GridBuilder> gridBuilder;
+			std::array<FormantGrid, 2> grids;
+			std::mutex gridMutex;
+			// gridIdx is the grid of the voices, the other one gets built.
+			// gridRequest is the wanted vowel pair, vowelClassA * NumVowelClasses + vowelClassB, or -1
+			std::atomic<int> gridIdx, gridRequest;
+			std::atomic<bool> gridBuilt;
 			EnvGenMultiVoice envGens;
 			PRMBlockD gainPRM;
 			std::array<Voice, NumMPEChannels> voices;
 			double attackMs, decayMs, releaseMs;
 			bool wannaUpdate;
+
+			const FormantGrid& getGrid() const noexcept;
+
+			// builds the requested grid, runs on the grid builder
+			int useTimeSlice() override;
 		};
 	}
 }
\ No newline at end of file
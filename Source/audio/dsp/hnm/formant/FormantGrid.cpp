@@ -0,0 +1,118 @@
+#include "FormantGrid.h"
+
+namespace dsp
+{
+	namespace formant
+	{
+		// FormantGrid
+
+		FormantGrid::FormantGrid() :
+			grid(NumBlends * NumQs),
+			gainsA(),
+			gainsB(),
+			sampleRate(0.),
+			vowelClassA(VowelClass::NumVowelClasses),
+			vowelClassB(VowelClass::NumVowelClasses)
+		{
+		}
+
+		void FormantGrid::prepare(double _sampleRate)
+		{
+			sampleRate = _sampleRate;
+			const auto a = vowelClassA == VowelClass::NumVowelClasses ? VowelClass::SopranoA : vowelClassA;
+			const auto b = vowelClassB == VowelClass::NumVowelClasses ? VowelClass::SopranoE : vowelClassB;
+			update(a, b);
+		}
+
+		void FormantGrid::update(VowelClass _vowelClassA, VowelClass _vowelClassB) noexcept
+		{
+			vowelClassA = _vowelClassA;
+			vowelClassB = _vowelClassB;
+			const auto& vowelA = toVowel(vowelClassA);
+			const auto& vowelB = toVowel(vowelClassB);
+
+			const auto normalize = [](Formants& gains, const Vowel& vowel)
+			{
+				auto maxGain = 0.;
+				for (auto i = 0; i < NumFormants; ++i)
+				{
+					gains[i] = math::dbToAmp(vowel.gainDb[i]);
+					maxGain = std::max(maxGain, gains[i]);
+				}
+				const auto gainInv = 1. / maxGain;
+				for (auto& gain : gains)
+					gain *= gainInv;
+			};
+			normalize(gainsA, vowelA);
+			normalize(gainsB, vowelB);
+
+			const auto fsInv = 1. / sampleRate;
+			for (auto b = 0; b < NumBlends; ++b)
+			{
+				const auto blend = static_cast<double>(b) / MaxBlendIdx;
+				for (auto qi = 0; qi < NumQs; ++qi)
+				{
+					const auto q = QMin + (QMax - QMin) * static_cast<double>(qi) / MaxQIdx;
+					auto& coefs = grid[b * NumQs + qi];
+					for (auto i = 0; i < NumFormants; ++i)
+					{
+						// same coefficients as Resonator2::update
+						const auto freqHz = vowelA.freqHz[i] + blend * (vowelB.freqHz[i] - vowelA.freqHz[i]);
+						const auto bwHz = (vowelA.bwHz[i] + blend * (vowelB.bwHz[i] - vowelA.bwHz[i])) * q;
+						const auto fc = freqHz * fsInv;
+						const auto bw = bwHz * fsInv;
+						const auto b2 = std::exp(-Tau * bw);
+						const auto b2_4 = 4. * b2;
+						const auto cosFc = std::cos(Tau * fc);
+						const auto b1 = (-b2_4 / (1. + b2)) * cosFc;
+						const auto sqrtVal = static_cast<float>(1. - b1 * b1 / b2_4);
+						coefs.a0[i] = (1. - b2) * std::sqrt(sqrtVal);
+						coefs.b1[i] = b1;
+						coefs.b2[i] = b2;
+					}
+				}
+			}
+		}
+
+		void FormantGrid::operator()(Coefficients& coefs, double blend, double q) const noexcept
+		{
+			const auto bIdx = math::limit(0., MaxBlendIdx, blend * MaxBlendIdx);
+			const auto qIdx = math::limit(0., MaxQIdx, (q - QMin) / (QMax - QMin) * MaxQIdx);
+			const auto b0 = std::min(static_cast<int>(bIdx), NumBlends - 2);
+			const auto q0 = std::min(static_cast<int>(qIdx), NumQs - 2);
+			const auto bFrac = bIdx - static_cast<double>(b0);
+			const auto qFrac = qIdx - static_cast<double>(q0);
+
+			// bilinear, which keeps the poles inside the unit circle,
+			// because the stable region of (b1, b2) is convex
+			const auto& c00 = get(b0, q0);
+			const auto& c01 = get(b0, q0 + 1);
+			const auto& c10 = get(b0 + 1, q0);
+			const auto& c11 = get(b0 + 1, q0 + 1);
+			const auto w00 = (1. - bFrac) * (1. - qFrac);
+			const auto w01 = (1. - bFrac) * qFrac;
+			const auto w10 = bFrac * (1. - qFrac);
+			const auto w11 = bFrac * qFrac;
+
+			const auto qInv = 1. / q;
+			for (auto i = 0; i < NumFormants; ++i)
+			{
+				coefs.a0[i] = w00 * c00.a0[i] + w01 * c01.a0[i] + w10 * c10.a0[i] + w11 * c11.a0[i];
+				coefs.b1[i] = w00 * c00.b1[i] + w01 * c01.b1[i] + w10 * c10.b1[i] + w11 * c11.b1[i];
+				coefs.b2[i] = w00 * c00.b2[i] + w01 * c01.b2[i] + w10 * c10.b2[i] + w11 * c11.b2[i];
+				// gains are cheap and 1/q isn't linear, so they are computed exactly
+				coefs.gain[i] = (gainsA[i] + blend * (gainsB[i] - gainsA[i])) * qInv;
+			}
+		}
+
+		VowelClass FormantGrid::getVowelClass(int idx) const noexcept
+		{
+			return idx == 0 ? vowelClassA : vowelClassB;
+		}
+
+		const Coefficients& FormantGrid::get(int b, int qi) const noexcept
+		{
+			return grid[b * NumQs + qi];
+		}
+	}
+}
\ No newline at end of file
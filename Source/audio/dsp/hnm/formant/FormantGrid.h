@@ -0,0 +1,54 @@
+#pragma once
+#include "../../../Using.h"
+#include "FormantAxiom.h"
+#include <vector>
+
+namespace dsp
+{
+	namespace formant
+	{
+		using Formants = std::array<double, NumFormants>;
+
+		struct Coefficients
+		{
+			Formants a0, b1, b2, gain;
+		};
+
+		// resonator coefficients of the current vowel pair on a grid of blend positions and q values.
+		// the voices interpolate the grid instead of computing exp, cos and sqrt for every formant
+		// whenever blend or q are moving, which is most of the time, because of the envelope.
+		class FormantGrid
+		{
+			static constexpr int NumBlends = 33;
+			static constexpr int NumQs = 17;
+			static constexpr double MaxBlendIdx = static_cast<double>(NumBlends - 1);
+			static constexpr double MaxQIdx = static_cast<double>(NumQs - 1);
+		public:
+			// range of the q values the voices ask for
+			static constexpr double QMin = .01;
+			static constexpr double QMax = .64;
+
+			FormantGrid();
+
+			// sampleRate
+			void prepare(double);
+
+			// vowelClassA, vowelClassB
+			void update(VowelClass, VowelClass) noexcept;
+
+			// coefficients, blend [0, 1], q [QMin, QMax]
+			void operator()(Coefficients&, double, double) const noexcept;
+
+			// idx [0, 1]
+			VowelClass getVowelClass(int) const noexcept;
+		private:
+			std::vector<Coefficients> grid;
+			Formants gainsA, gainsB;
+			double sampleRate;
+			VowelClass vowelClassA, vowelClassB;
+
+			// blendIdx, qIdx
+			const Coefficients& get(int, int) const noexcept;
+		};
+	}
+}
\ No newline at end of file
@@ -450,37 +450,74 @@ namespace dsp
 			status(StatusMat::Processing),
 			name("init material"),
 			sampleRate(0.f),
-			soloing(false)
+			soloing(false),
+			pathsMatStr(),
+			pathsMag(),
+			pathsFc()
 		{
 		}
 
+		void Material::updatePaths(const String& matStr) const
+		{
+			if (pathsMatStr == matStr)
+				return;
+			pathsMatStr = matStr;
+			for (auto j = 0; j < NumPartials; ++j)
+			{
+				const auto peakStr = matStr + "pk" + String(j);
+				pathsMag[j] = arch::StatePath(peakStr + "mg");
+				pathsFc[j] = arch::StatePath(peakStr + "fc");
+			}
+		}
+
 		void Material::savePatch(arch::State& state, const String& matStr) const
 		{
+			updatePaths(matStr);
 			for (auto j = 0; j < NumPartials; ++j)
 			{
 				const auto& peakInfo = peakInfos[j];
-				const auto peakStr = matStr + "pk" + String(j);
-				state.set(peakStr + "mg", peakInfo.mag);
-				state.set(peakStr + "fc", peakInfo.fc);
+				state.set(pathsMag[j], peakInfo.mag);
+				state.set(pathsFc[j], peakInfo.fc);
 			}
 		}
 
 		void Material::loadPatch(const arch::State& state, const String& matStr)
 		{
+			updatePaths(matStr);
 			for (auto j = 0; j < NumPartials; ++j)
 			{
 				auto& peakInfo = peakInfos[j];
-				const auto peakStr = matStr + "pk" + juce::String(j);
-				const auto magVal = state.get(peakStr + "mg");
+				const auto magVal = state.get(pathsMag[j]);
 				if (magVal != nullptr)
 					peakInfo.mag = static_cast<double>(*magVal);
-				const auto fcVal = state.get(peakStr + "fc");
+				const auto fcVal = state.get(pathsFc[j]);
 				if (fcVal != nullptr)
 					peakInfo.fc = static_cast<double>(*fcVal);
 			}
 			updatePeakInfosFromGUI();
 		}
 
+		void Material::savePatch(float* dest) const
+		{
+			for (auto j = 0; j < NumPartials; ++j)
+			{
+				const auto& peakInfo = peakInfos[j];
+				dest[2 * j] = static_cast<float>(peakInfo.mag);
+				dest[2 * j + 1] = static_cast<float>(peakInfo.fc);
+			}
+		}
+
+		void Material::loadPatch(const float* src)
+		{
+			for (auto j = 0; j < NumPartials; ++j)
+			{
+				auto& peakInfo = peakInfos[j];
+				peakInfo.mag = static_cast<double>(src[2 * j]);
+				peakInfo.fc = static_cast<double>(src[2 * j + 1]);
+			}
+			updatePeakInfosFromGUI();
+		}
+
 		void Material::load()
 		{
 			if (math::bufferSilent(buffer.data(), FFTSize))
@@ -686,5 +723,33 @@ namespace dsp
 		{
 			return actives;
 		}
+
+		// DUALMATERIALDATA
+
+		DualMaterialData::DualMaterialData() :
+			data(),
+			actives()
+		{
+			for (auto& active : actives)
+				active = true;
+		}
+
+		void DualMaterialData::copy(const DualMaterial& dualMaterial) noexcept
+		{
+			for (auto m = 0; m < 2; ++m)
+				data[m].copy(dualMaterial.getMaterialData(m));
+			for (auto i = 0; i < NumPartials; ++i)
+				actives[i] = dualMaterial.isActive(i);
+		}
+
+		const MaterialData& DualMaterialData::getMaterialData(int i) const noexcept
+		{
+			return data[i];
+		}
+
+		const bool DualMaterialData::isActive(int i) const noexcept
+		{
+			return actives[i];
+		}
 	}
 }
\ No newline at end of file
@@ -79,6 +79,15 @@ namespace dsp
 			// state, matStr
 			void loadPatch(const arch::State&, const String&);
 
+			// floats of the partials in the binary state: mag, fc
+			static constexpr int NumFloats = NumPartials * 2;
+
+			// dest
+			void savePatch(float*) const;
+
+			// src
+			void loadPatch(const float*);
+
 			// data, size
 			void load(const char*, int);
 
@@ -105,9 +114,15 @@ namespace dsp
 				std::vector<int> indexes;
 			};
 		private:
+			// state paths of the partials, resolved once per matStr
+			mutable String pathsMatStr;
+			mutable std::array<arch::StatePath, NumPartials> pathsMag, pathsFc;
 
 			// data, size
 			void fillBuffer(const char*, int);
+
+			// matStr
+			void updatePaths(const String&) const;
 		};
 
 		void generateSine(Material&);
@@ -140,5 +155,23 @@ namespace dsp
 			std::array<Material, 2> materials;
 			ActivesArray actives;
 		};
+
+		// what the voices read of both materials. each engine keeps its own copy, so that it can play out
+		// a patch while the editor or the next patch already changes the materials
+		struct DualMaterialData
+		{
+			DualMaterialData();
+
+			// dualMaterial
+			void copy(const DualMaterial&) noexcept;
+
+			const MaterialData& getMaterialData(int) const noexcept;
+
+			const bool isActive(int) const noexcept;
+
+		protected:
+			std::array<MaterialData, 2> data;
+			ActivesArray actives;
+		};
 	}
 }
\ No newline at end of file
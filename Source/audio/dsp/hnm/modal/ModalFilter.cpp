@@ -4,8 +4,9 @@ namespace dsp
 {
 	namespace modal
 	{
-		ModalFilter::ModalFilter() :
-			materials(),
+		ModalFilter::ModalFilter(DualMaterial& _materials) :
+			materials(_materials),
+			materialData(),
 			voices(),
 			transposeSemi(0.)
 		{
@@ -13,6 +14,7 @@ namespace dsp
 
 		void ModalFilter::prepare(double sampleRate) noexcept
 		{
+			materialData.copy(materials);
 			materials.reportUpdate();
 			for (auto v = 0; v < voices.size(); ++v)
 			{
@@ -27,9 +29,15 @@ namespace dsp
 			if (!materials.updated())
 				return;
 
+			updateMaterials();
+			materials.reportUpdate();
+		}
+
+		void ModalFilter::updateMaterials() noexcept
+		{
+			materialData.copy(materials);
 			for (auto& voice : voices)
 				voice.reportMaterialUpdate();
-			materials.reportUpdate();
 		}
 
 		void ModalFilter::operator()(double** samples, const Voice::Parameters& params,
@@ -37,7 +45,7 @@ namespace dsp
 		{
 			voices[v]
 			(
-				samples, materials, params,
+				samples, materialData, params,
 				envGenMod, numChannels, numSamples
 			);
 		}
@@ -69,6 +77,11 @@ namespace dsp
 			voices[v].triggerNoteOff();
 		}
 
+		void ModalFilter::silence(int v) noexcept
+		{
+			voices[v].silence();
+		}
+
 		void ModalFilter::triggerPitchbend(const arch::XenManager& xen,
 			double pitchbend, int numChannels, int v) noexcept
 		{
@@ -80,6 +93,22 @@ namespace dsp
 			return voices[i].isRinging();
 		}
 
+		void ModalFilter::setMeasureEnergies(bool e) noexcept
+		{
+			for (auto& voice : voices)
+				voice.setMeasureEnergies(e);
+		}
+
+		double ModalFilter::getEnergy(int i, int v) const noexcept
+		{
+			return voices[v].getEnergy(i);
+		}
+
+		double ModalFilter::getFreqHz(int v) const noexcept
+		{
+			return voices[v].getFreqHz();
+		}
+
 		Material& ModalFilter::getMaterial(int i) noexcept
 		{
 			return materials.getMaterial(i);
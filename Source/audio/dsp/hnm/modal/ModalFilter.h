@@ -8,13 +8,18 @@ namespace dsp
 	{
 		struct ModalFilter
 		{
-			ModalFilter();
+			// materials, shared with the editor and the other engine
+			ModalFilter(DualMaterial&);
 
 			// sampleRate
 			void prepare(double) noexcept;
 
+			// picks up the materials if the editor or a patch changed them
 			void operator()() noexcept;
 
+			// picks up the materials whether they changed or not
+			void updateMaterials() noexcept;
+
 			// samples, params, xen, envGenMod, numChannels, numSamples, v
 			void operator()(double**, const Voice::Parameters&,
 				double, int, int, int) noexcept;
@@ -32,12 +37,24 @@ namespace dsp
 			// v
 			void triggerNoteOff(int) noexcept;
 
+			// v
+			void silence(int) noexcept;
+
 			// xen, pitchbend, numChannels, v
 			void triggerPitchbend(const arch::XenManager&,
 				double, int, int) noexcept;
 
 			bool isRinging(int) const noexcept;
 
+			// enabled, only the editor reads the energies, so they are measured while it exists
+			void setMeasureEnergies(bool) noexcept;
+
+			// partialIdx, v
+			double getEnergy(int, int) const noexcept;
+
+			// v
+			double getFreqHz(int) const noexcept;
+
 			Material& getMaterial(int) noexcept;
 
 			const Material& getMaterial(int) const noexcept;
@@ -50,7 +67,8 @@ namespace dsp
 			void randomizeMaterial(arch::RandSeed&, int);
 
 		private:
-			DualMaterial materials;
+			DualMaterial& materials;
+			DualMaterialData materialData;
 			std::array<Voice, NumMPEChannels> voices;
 			double transposeSemi;
 		};
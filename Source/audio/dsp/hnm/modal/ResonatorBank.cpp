@@ -64,7 +64,10 @@ namespace dsp
 			nyquist(.5),
 			autoGainReso(),
 			numFiltersBelowNyquist{ 0, 0 },
-			sleepy()
+			sleepy(),
+			energies(),
+			energyCoeff(1.),
+			measureEnergies(false)
 		{
 		}
 
@@ -73,6 +76,7 @@ namespace dsp
 			for(auto ch = 0; ch < 2; ++ch)
 				for (auto i = 0; i < NumPartials; ++i)
 					resonators[i].reset(ch);
+			energies.fill(0.);
 		}
 
 		void ResonatorBank::prepare(const MaterialDataStereo& materialStereo, double _sampleRate)
@@ -80,6 +84,7 @@ namespace dsp
 			sampleRate = _sampleRate;
 			sampleRateInv = 1. / sampleRate;
 			nyquist = sampleRate * .5;
+			energyCoeff = 1. - std::exp(-static_cast<double>(ChunkSize) / math::msToSamples(EnergyMs, sampleRate));
 			reset();
 			val.reset();
 			for (auto& n : numFiltersBelowNyquist)
@@ -128,6 +133,12 @@ namespace dsp
 			sleepy.triggerNoteOff();
 		}
 
+		void ResonatorBank::silence() noexcept
+		{
+			reset();
+			sleepy.sleep();
+		}
+
 		void ResonatorBank::triggerPitchbend(const MaterialDataStereo& materialStereo, const arch::XenManager& xen,
 			double pitchbend, int numChannels) noexcept
 		{
@@ -141,6 +152,24 @@ namespace dsp
 			return sleepy.isRinging();
 		}
 
+		void ResonatorBank::setMeasureEnergies(bool e) noexcept
+		{
+			if (measureEnergies == e)
+				return;
+			measureEnergies = e;
+			energies.fill(0.);
+		}
+
+		double ResonatorBank::getEnergy(int i) const noexcept
+		{
+			return energies[i];
+		}
+
+		double ResonatorBank::getFreqHz() const noexcept
+		{
+			return freqHz;
+		}
+
 		bool ResonatorBank::setFrequencyHz(const MaterialDataStereo& materialStereo,
 			double freq, int numChannels) noexcept
 		{
@@ -204,28 +233,62 @@ namespace dsp
 		void ResonatorBank::applyFilter(const MaterialDataStereo& materialStereo, double** samples,
 			int numChannels, int numSamples) noexcept
 		{
+			// each partial runs over a whole chunk at once, so its loop can be inlined and unrolled
+			alignas(64) std::array<double, ChunkSize> wet, bpY;
+			const auto numChannelsInv = 1. / static_cast<double>(numChannels);
+
 			for (auto ch = 0; ch < numChannels; ++ch)
 			{
 				const auto& material = materialStereo[ch];
 				const auto nfbn = numFiltersBelowNyquist[ch];
 				const auto autoGain = autoGainReso(ch);
+				const auto autoGainSquared = autoGain * autoGain;
 				auto smpls = samples[ch];
 
-				for (auto i = 0; i < numSamples; ++i)
+				if (measureEnergies)
+					for (auto f = nfbn; f < NumPartials; ++f)
+						energies[f] = 0.;
+
+				for (auto s0 = 0; s0 < numSamples; s0 += ChunkSize)
 				{
-					const auto dry = smpls[i];
-					auto wet = 0.;
-					
-					for (auto f = 0; f < nfbn; ++f)
+					const auto chunkSize = std::min(ChunkSize, numSamples - s0);
+					const auto chunk = &smpls[s0];
+					const auto chunkSizeD = static_cast<double>(chunkSize);
+					// shorter chunks and more channels move the energies proportionally less
+					const auto coeff = energyCoeff * chunkSizeD * numChannelsInv / static_cast<double>(ChunkSize);
+					std::fill(wet.begin(), wet.begin() + chunkSize, 0.);
+
+					if (measureEnergies)
+					{
+						for (auto f = 0; f < nfbn; ++f)
+						{
+							const auto mag = material.getMag(f);
+							resonators[f].process(chunk, bpY.data(), chunkSize, ch);
+							auto sum = 0.;
+							for (auto i = 0; i < chunkSize; ++i)
+							{
+								const auto y = bpY[i] * mag;
+								wet[i] += y;
+								sum += y * y;
+							}
+							const auto meanSquare = sum * autoGainSquared / chunkSizeD;
+							energies[f] += coeff * (meanSquare - energies[f]);
+						}
+					}
+					else
 					{
-						auto& resonator = resonators[f];
-						const auto mag = material.getMag(f);
-						const auto bpY = resonator(dry, ch) * mag;
-						wet += bpY;
+						// nobody looks at the energies, so only the sum is needed
+						for (auto f = 0; f < nfbn; ++f)
+						{
+							const auto mag = material.getMag(f);
+							resonators[f].process(chunk, bpY.data(), chunkSize, ch);
+							for (auto i = 0; i < chunkSize; ++i)
+								wet[i] += bpY[i] * mag;
+						}
 					}
 
-					wet *= autoGain;
-					smpls[i] = wet;
+					for (auto i = 0; i < chunkSize; ++i)
+						chunk[i] = wet[i] * autoGain;
 				}
 			}
 		}
@@ -11,6 +11,8 @@ namespace dsp
 		class ResonatorBank
 		{
 			using ResonatorArray = std::array<ResonatorStereo2, NumPartials>;
+			static constexpr int ChunkSize = BlockSize2x;
+			static constexpr double EnergyMs = 40.;
 
 			struct Val
 			{
@@ -69,6 +71,9 @@ namespace dsp
 
 			void triggerNoteOff() noexcept;
 
+			// clears the voice's state, so that it stops ringing immediately
+			void silence() noexcept;
+
 			// materialStereo, xen, pitchbend, numChannels
 			void triggerPitchbend(const MaterialDataStereo&, const arch::XenManager&,
 				double, int) noexcept;
@@ -84,6 +89,15 @@ namespace dsp
 
 			bool isRinging() const noexcept;
 
+			// enabled, the energies stay at 0 while they are not measured
+			void setMeasureEnergies(bool) noexcept;
+
+			// mean square of each partial's contribution to the output, smoothed over EnergyMs
+			// partialIdx
+			double getEnergy(int) const noexcept;
+
+			double getFreqHz() const noexcept;
+
 		private:
 			ResonatorArray resonators;
 			Val val;
@@ -91,6 +105,9 @@ namespace dsp
 			ResoGain autoGainReso;
 			std::array<int, 2> numFiltersBelowNyquist;
 			SleepyDetector sleepy;
+			std::array<double, NumPartials> energies;
+			double energyCoeff;
+			bool measureEnergies;
 
 			// material, numFiltersBelowNyquist, ch
 			void updateFreqRatios(const MaterialData&, int&, int) noexcept;
@@ -121,7 +121,7 @@ namespace dsp
 			snapParameterValues = false;
 		}
 
-		void Voice::operator()(double** samples, const DualMaterial& dualMaterial,
+		void Voice::operator()(double** samples, const DualMaterialData& dualMaterial,
 			const Parameters& params, double envGenMod, int numChannels, int numSamples) noexcept
 		{
 			updateParameters(dualMaterial, params, envGenMod, numChannels);
@@ -157,6 +157,11 @@ namespace dsp
 			resonatorBank.triggerNoteOff();
 		}
 
+		void Voice::silence() noexcept
+		{
+			resonatorBank.silence();
+		}
+
 		void Voice::triggerPitchbend(const arch::XenManager& xen,
 			double pitchbend, int numChannels) noexcept
 		{
@@ -168,6 +173,21 @@ namespace dsp
 			return resonatorBank.isRinging();
 		}
 
+		void Voice::setMeasureEnergies(bool e) noexcept
+		{
+			resonatorBank.setMeasureEnergies(e);
+		}
+
+		double Voice::getEnergy(int i) const noexcept
+		{
+			return resonatorBank.getEnergy(i);
+		}
+
+		double Voice::getFreqHz() const noexcept
+		{
+			return resonatorBank.getFreqHz();
+		}
+
 		void Voice::blendMags(MaterialData& dest,
 			const MaterialData& src0, const MaterialData& src1,
 			double blend, int i) noexcept
@@ -209,7 +229,7 @@ namespace dsp
 			dest[i].fc = r + harmi * (rTuned - r);
 		}
 
-		void Voice::updateParameters(const DualMaterial& dualMaterial,
+		void Voice::updateParameters(const DualMaterialData& dualMaterial,
 			const Parameters& _parameters, double envGenMod, int numChannels) noexcept
 		{
 			const auto envGenValue = envGenMod;
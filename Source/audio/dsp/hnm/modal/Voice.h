@@ -55,7 +55,7 @@ namespace dsp
 			void prepare(double) noexcept;
 
 			// samples, dualMaterial, parameters, envGenMod, numChannels, numSamples
-			void operator()(double**, const DualMaterial&,
+			void operator()(double**, const DualMaterialData&,
 				const Parameters&, double, int, int) noexcept;
 
 			// xen, transposeSemi, numChannels
@@ -70,6 +70,9 @@ namespace dsp
 
 			void triggerNoteOff() noexcept;
 
+			// clears the voice's state, so that it stops ringing immediately
+			void silence() noexcept;
+
 			// xen, pitchbend, numChannels
 			void triggerPitchbend(const arch::XenManager&,
 				double, int) noexcept;
@@ -78,6 +81,14 @@ namespace dsp
 
 			bool isRinging() const noexcept;
 
+			// enabled
+			void setMeasureEnergies(bool) noexcept;
+
+			// partialIdx
+			double getEnergy(int) const noexcept;
+
+			double getFreqHz() const noexcept;
+
 		private:
 			MaterialDataStereo materialStereo;
 			std::array<ParameterProcessor, kNumParams> parameters;
@@ -94,7 +105,7 @@ namespace dsp
 			void updatePartial(MaterialData&, double, double, int) noexcept;
 
 			// dualMaterial, parameters, envGenMod, numChannels
-			void updateParameters(const DualMaterial&,
+			void updateParameters(const DualMaterialData&,
 				const Parameters&, double, int) noexcept;
 		};
 	}
@@ -10,6 +10,7 @@ namespace dsp
 	AutoMPE::AutoMPE() :
 		buffer(),
 		voices(),
+		energies(),
 		channelIdx(-1),
 		poly(VoicesSize)
 	{}
@@ -19,8 +20,16 @@ namespace dsp
 		return voices;
 	}
 
-	void AutoMPE::operator()(MidiBuffer& midi, int _poly)
+	void AutoMPE::reset() noexcept
 	{
+		for (auto& voice : voices)
+			voice.note = -1;
+		channelIdx = -1;
+	}
+
+	void AutoMPE::operator()(MidiBuffer& midi, const Energies& _energies, int _poly)
+	{
+		energies = _energies;
 		buffer.clear();
 		updatePoly(_poly);
 		processBlock(midi);
@@ -54,8 +63,10 @@ namespace dsp
 				processNoteOn(msg, ts);
 			else if (msg.isNoteOff())
 				processNoteOff(msg, ts);
-			else if (msg.isPitchWheel())
-				processPitchWheel(msg, ts);
+			else if (msg.isPitchWheel() || msg.isChannelPressure() || msg.isControllerOfType(74))
+				processBroadcast(msg, ts);
+			else if (msg.isAftertouch())
+				processAftertouch(msg, ts);
 			else
 			{
 				msg.setChannel(1);
@@ -71,23 +82,45 @@ namespace dsp
 			channelIdx = 0;
 	}
 
+	int AutoMPE::getQuietest(bool released) const noexcept
+	{
+		auto quietest = -1;
+		auto energyMin = std::numeric_limits<double>::max();
+		for (auto v = 0; v < poly; ++v)
+		{
+			const bool isReleased = voices[v].note == -1;
+			if (isReleased == released && energies[v] < energyMin)
+			{
+				energyMin = energies[v];
+				quietest = v;
+			}
+		}
+		return quietest;
+	}
+
 	void AutoMPE::processNoteOn(MidiMessage& msg, int ts)
 	{
+		// idle voices first
 		for (auto ch = 0; ch < poly; ++ch)
 		{
 			incChannelIdx();
 			auto& voice = voices[channelIdx];
-			const bool voiceAvailable = voice.note == -1;
-			if (voiceAvailable)
+			const bool voiceIdle = voice.note == -1 && energies[channelIdx] == 0.;
+			if (voiceIdle)
 			{
 				voice.channel = channelIdx + 2;
 				return processNoteOn(voice, msg, ts);
 			}
 		}
-		incChannelIdx();
+		// then the quietest tail, then the quietest held note
+		auto v = getQuietest(true);
+		if (v == -1)
+			v = getQuietest(false);
+		channelIdx = v;
 		auto& voice = voices[channelIdx];
 		voice.channel = channelIdx + 2;
-		buffer.addEvent(MidiMessage::noteOff(voice.channel, voice.note), ts);
+		if (voice.note != -1)
+			buffer.addEvent(MidiMessage::noteOff(voice.channel, voice.note), ts);
 		processNoteOn(voice, msg, ts);
 	}
 
@@ -126,7 +159,7 @@ namespace dsp
 		buffer.addEvent(msg, ts);
 	}
 
-	void AutoMPE::processPitchWheel(MidiMessage& msg, int ts) noexcept
+	void AutoMPE::processBroadcast(MidiMessage& msg, int ts) noexcept
 	{
 		for (auto ch = 0; ch < poly; ++ch)
 		{
@@ -135,4 +168,19 @@ namespace dsp
 			buffer.addEvent(msg, ts);
 		}
 	}
+
+	void AutoMPE::processAftertouch(MidiMessage& msg, int ts) noexcept
+	{
+		const auto nn = msg.getNoteNumber();
+		for (auto ch = 0; ch < poly; ++ch)
+		{
+			auto& voice = voices[ch];
+			if (voice.note == nn)
+			{
+				msg.setChannel(voice.channel);
+				buffer.addEvent(msg, ts);
+				return;
+			}
+		}
+	}
 }
\ No newline at end of file
@@ -17,17 +17,23 @@ namespace dsp
 
 		static constexpr int VoicesSize = NumMPEChannels;
 		using Voices = std::array<Voice, VoicesSize>;
+		// energy of each voice's output, 0 if the voice sleeps
+		using Energies = std::array<double, VoicesSize>;
 
 		AutoMPE();
 
-		// midi, poly
-		void operator()(MidiBuffer&, int);
+		// midi, energies, poly
+		void operator()(MidiBuffer&, const Energies&, int);
 
 		const Voices& getVoices() const noexcept;
 
+		// forgets all held notes
+		void reset() noexcept;
+
 	private:
 		MidiBuffer buffer;
 		Voices voices;
+		Energies energies;
 		int channelIdx, poly;
 
 		void updatePoly(int);
@@ -36,6 +42,9 @@ namespace dsp
 
 		void incChannelIdx() noexcept;
 
+		// released, returns the quietest voice with or without a held note or -1
+		int getQuietest(bool) const noexcept;
+
 		// msg, ts
 		void processNoteOn(MidiMessage&, int);
 
@@ -48,7 +57,12 @@ namespace dsp
 		// voice, msg, ts
 		void processNoteOff(Voice&, MidiMessage&, int) noexcept;
 
+		// pitchbend, channel pressure and slide reach all voices
+		// msg, ts
+		void processBroadcast(MidiMessage&, int) noexcept;
+
+		// polyphonic aftertouch only reaches the voice playing its note
 		// msg, ts
-		void processPitchWheel(MidiMessage&, int) noexcept;
+		void processAftertouch(MidiMessage&, int) noexcept;
 	};
 }
\ No newline at end of file
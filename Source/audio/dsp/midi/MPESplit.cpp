@@ -35,4 +35,9 @@ namespace dsp
 	{
 		return buffers[ch];
 	}
+
+	bool MPESplit::hasEvents(int ch) const noexcept
+	{
+		return buffers[ch].getNumEvents() > 1;
+	}
 }
\ No newline at end of file
@@ -17,6 +17,9 @@ namespace dsp
 
 		const MidiBuffer& operator[](int ch) const noexcept;
 
+		// true if channel ch got more than its terminating event
+		bool hasEvents(int ch) const noexcept;
+
 	protected:
 		Buffers buffers;
 	};
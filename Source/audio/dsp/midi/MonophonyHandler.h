@@ -27,6 +27,13 @@ namespace dsp
 			processBlockPoly(midi);
 		}
 
+		// forgets all held notes
+		void reset() noexcept
+		{
+			heldNotes.fill(0);
+			curNote = -1;
+		}
+
 	private:
 		MidiBuffer buffer;
 		std::array<uint8, 128> heldNotes;
@@ -42,7 +42,7 @@ namespace gui
 		{
             Random rand;
 
-            img = Image(Image::ARGB, w, h, true);
+            img = Image(Image::ARGB, w, h, true, juce::SoftwareImageType());
 			Graphics g(img);
 			g.setColour(getColour(CID::Txt));
 			
@@ -84,23 +84,9 @@ namespace gui
 		}
     }
 
-    void loadImage(const File& file, Image& img)
+    File getBgImageFile(const File& settingsFile)
     {
-        const auto nFile = file.getParentDirectory();
-        const auto findFiles = File::TypesOfFileToFind::findFiles;
-        const auto wildCard = "*.png";
-        for (const auto& f : nFile.findChildFiles(findFiles, true, wildCard))
-        {
-            if (f.getFileName() == "bgImage.png")
-            {
-                auto nImg = ImageFileFormat::loadFrom(f);
-                if (nImg.isValid())
-                {
-                    img = nImg;
-                    return;
-                }
-            }
-        }
+        return settingsFile.getParentDirectory().getChildFile("bgImage.png");
     }
 
     bool componentOk(Component& comp) noexcept
@@ -108,16 +94,6 @@ namespace gui
         return comp.getWidth() > 0 && comp.getHeight() > 0;
     }
 
-    void saveImage(const File& file, const Image& img)
-    {
-        const auto nFile = file.getParentDirectory().getChildFile("bgImage.png");
-        if (nFile.exists())
-            nFile.deleteFile();
-        FileOutputStream stream(nFile);
-        PNGImageFormat pngWriter;
-        pngWriter.writeImageToStream(img, stream);
-    }
-
     void makeImageRefreshButton(Button& btn, const String& tooltip)
     {
         const auto onPaint = [](Graphics& g, const Button& button)
@@ -165,7 +141,8 @@ namespace gui
         Comp(u),
         img(),
         refreshButton(u),
-        createImageFunc([](Image&) {})
+        createImageFunc([](Image&) {}),
+        worker(Image::ARGB)
     {
         setInterceptsMouseClicks(false, true);
 
@@ -173,7 +150,6 @@ namespace gui
         refreshButton.onClick = [&](const Mouse&)
         {
             updateBgImage(false);
-            repaint();
         };
 
         updateBgImage(false);
@@ -181,16 +157,17 @@ namespace gui
 
         add(Callback([&]()
         {
+            if (worker.fetch(img))
+                repaint();
             if (!img.isValid())
                 return;
             const auto w = getWidth();
             const auto h = getHeight();
-            if (img.getWidth() == w && img.getHeight() == h)
+            if (worker.hasSize(w, h))
                 return;
 
             updateBgImage(false);
-            repaint();
-        }, kUpdateBoundsCB, cbFPS::k3_75, true));
+        }, kUpdateBoundsCB, cbFPS::k3_75, true, Callback::Priority::Low));
     }
 
     void BgImage::paint(Graphics& g)
@@ -209,15 +186,19 @@ namespace gui
     {
         auto& props = utils.audioProcessor.state.props;
         auto& user = *props.getUserSettings();
-        const auto& file = user.getFile();
+        const auto file = getBgImageFile(user.getFile());
         if (!forcedLoad)
-            loadImage(file, img);
+            worker.load(file);
 
         if (componentOk(*this))
         {
-            img = Image(Image::ARGB, getWidth(), getHeight(), true);
-            createImageFunc(img);
-            saveImage(file, img);
+            worker.setSize(getWidth(), getHeight());
+            worker.render([createImage = createImageFunc](Image& canvas)
+            {
+                canvas.clear(canvas.getBounds());
+                createImage(canvas);
+            });
+            worker.save(file);
         }
     }
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "Button.h"
+#include "RenderWorker.h"
 
 namespace gui
 {
@@ -19,6 +20,8 @@ namespace gui
 
 		Image img;
 		Button refreshButton;
+		// runs on the render worker
 		std::function<void(Image&)> createImageFunc;
+		RenderWorker worker;
 	};
 }
\ No newline at end of file
@@ -4,7 +4,7 @@ namespace gui
 {
 	ColoursEditor::ColoursEditor(Utils& u) :
 		Comp(u),
-		selector(std::make_unique<ColourSelector>(26, 4, 7)),
+		selector(nullptr),
 		buttonsColour
 		{
 			Button(u),
@@ -20,7 +20,6 @@ namespace gui
 		lastColour(Colours::c(cIdx))
 	{
 		setOpaque(true);
-		selector->setMouseCursor(makeCursor());
 
 		layout.init
 		(
@@ -28,7 +27,6 @@ namespace gui
 			{ 8, 1 }
 		);
 
-		addAndMakeVisible(*selector);
 		for (auto i = 0; i < NumColours; ++i)
 		{
 			auto& button = buttonsColour[i];
@@ -44,31 +42,14 @@ namespace gui
 			{
 				cIdx = i;
 				lastColour = Colours::c(cIdx);
-				removeChildComponent(selector.get());
-				const auto cID = static_cast<CID>(cIdx);
-				switch (cID)
-				{
-				case CID::Bg:
-				case CID::Txt:
-				case CID::Interact:
-				case CID::Mod:
-					selector = std::make_unique<ColourSelector>(26, 4, 7);
-					break;
-				case CID::Hover:
-				case CID::Darken:
-					selector = std::make_unique<ColourSelector>(27, 4, 7);
-					break;
-				}
-				addAndMakeVisible(*selector);
-				selector->setCurrentColour(Colours::c(cIdx));
 				for (auto& button : buttonsColour)
 					button.value = 0.f;
 				buttonsColour[cIdx].value = 1.f;
-				resized();
+				if (selector != nullptr)
+					makeSelector();
 			};
 		}
 		buttonsColour[cIdx].value = 1.f;
-		selector->setCurrentColour(Colours::c(cIdx));
 
 		addAndMakeVisible(buttonRevert);
 		addAndMakeVisible(buttonDefault);
@@ -80,7 +61,8 @@ namespace gui
 		{
 			const auto cID = static_cast<CID>(cIdx);
 			Colours::c.set(lastColour, cID);
-			selector->setCurrentColour(lastColour);
+			if (selector != nullptr)
+				selector->setCurrentColour(lastColour);
 			utils.pluginTop.repaint();
 			notifyUpdate(cID);
 		};
@@ -90,7 +72,8 @@ namespace gui
 			const auto cID = static_cast<CID>(cIdx);
 			const auto col = toDefault(cID);
 			Colours::c.set(col, cID);
-			selector->setCurrentColour(col);
+			if (selector != nullptr)
+				selector->setCurrentColour(col);
 			utils.pluginTop.repaint();
 			notifyUpdate(cID);
 		};
@@ -99,6 +82,8 @@ namespace gui
 		const auto speed = msToInc(AniLengthMs, fps);
 		add(Callback([&, speed]()
 		{
+			if (selector == nullptr)
+				return;
 			const auto selectorCol = selector->getCurrentColour();
 			const auto curCol = Colours::c(cIdx);
 			if (selectorCol == curCol)
@@ -130,7 +115,8 @@ namespace gui
 			}
 		}
 
-		layout.place(*selector, 1, 0, 1, 1);
+		if (selector != nullptr)
+			layout.place(*selector, 1, 0, 1, 1);
 
 		const auto buttonsBottomBounds = layout(1, 1, 1, 1);
 		{
@@ -150,6 +136,33 @@ namespace gui
 		g.fillAll(Colour(0xff000000));
 	}
 
+	void ColoursEditor::visibilityChanged()
+	{
+		if (selector == nullptr && isVisible())
+			makeSelector();
+	}
+
+	void ColoursEditor::makeSelector()
+	{
+		if (selector != nullptr)
+			removeChildComponent(selector.get());
+		const auto cID = static_cast<CID>(cIdx);
+		switch (cID)
+		{
+		case CID::Hover:
+		case CID::Darken:
+			selector = std::make_unique<ColourSelector>(27, 4, 7);
+			break;
+		default:
+			selector = std::make_unique<ColourSelector>(26, 4, 7);
+			break;
+		}
+		selector->setMouseCursor(makeCursor());
+		addAndMakeVisible(*selector);
+		selector->setCurrentColour(Colours::c(cIdx));
+		resized();
+	}
+
 	ButtonColours::ButtonColours(ColoursEditor& menu) :
 		Button(menu.utils),
 		img()
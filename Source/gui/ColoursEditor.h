@@ -14,6 +14,8 @@ namespace gui
 
 		void paint(Graphics&) override;
 
+		void visibilityChanged() override;
+
 	private:
 		std::unique_ptr<ColourSelector> selector;
 		std::array<Button, NumColours> buttonsColour;
@@ -22,6 +24,9 @@ namespace gui
 		Colour lastColour;
 
 		void notifyUpdate(CID);
+
+		// the selector is only created once the editor is shown
+		void makeSelector();
 	};
 
 	struct ButtonColours :
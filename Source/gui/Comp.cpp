@@ -48,7 +48,10 @@ namespace gui
 	void Comp::registerCallbacks()
 	{
 		for (auto& cb : callbacks)
+		{
+			cb.name = typeid(*this).name();
 			utils.add(&cb);
+		}
 	}
 
 	void Comp::initLayout(const String& xL, const String& yL)
@@ -8,7 +8,8 @@ namespace gui
 		Comp(u),
 		img(),
 		pos(),
-		zoomFactor(1.f)
+		zoomFactor(1.f),
+		request(std::make_shared<std::atomic<int>>(0))
 	{
 	}
 
@@ -36,9 +37,28 @@ namespace gui
 
 	void Credits::ZoomImage::init(const void* data, int size)
 	{
+		const auto r = request->fetch_add(1) + 1;
 		if (data == nullptr)
 			return;
-		img = ImageCache::getFromMemory(data, size);
+		const auto hashCode = static_cast<juce::int64>(reinterpret_cast<juce::pointer_sized_int>(data));
+		img = ImageCache::getFromCacheWithHashCode(hashCode);
+		repaint();
+		if (img.isValid())
+			return;
+		// decoding a credits page takes longer than a frame, so it happens on the render worker
+		RenderWorker::launch([data, size, r, req = request, safe = SafePointer<ZoomImage>(this)]()
+		{
+			if (req->load() != r)
+				return;
+			const auto nImg = ImageCache::getFromMemory(data, size);
+			juce::MessageManager::callAsync([nImg, r, req, safe]()
+			{
+				if (safe == nullptr || req->load() != r)
+					return;
+				safe->img = nImg;
+				safe->repaint();
+			});
+		});
 	}
 
 	void Credits::ZoomImage::mouseEnter(const Mouse& mouse)
@@ -204,7 +224,8 @@ namespace gui
 		previous(u),
 		next(u),
 		entry(u),
-		idx(0)
+		idx(0),
+		pageLoaded(false)
 	{
 		layout.init
 		(
@@ -257,7 +278,9 @@ namespace gui
 	void Credits::init()
 	{
 		idx = 0;
-		entry.init(pages[idx], static_cast<int>(pages.size()));
+		pageLoaded = false;
+		if (isVisible())
+			visibilityChanged();
 	}
 
 	void Credits::paint(Graphics& g)
@@ -274,6 +297,14 @@ namespace gui
 		layout.place(entry, 1, 1, 1, 1);
 	}
 
+	void Credits::visibilityChanged()
+	{
+		if (pageLoaded || !isVisible() || pages.empty())
+			return;
+		pageLoaded = true;
+		flipPage();
+	}
+
 	void Credits::flipPage()
 	{
 		entry.init(pages[idx], static_cast<int>(pages.size()));
@@ -1,5 +1,6 @@
 #pragma once
 #include "ButtonLink.h"
+#include "RenderWorker.h"
 
 namespace gui
 {
@@ -47,6 +48,8 @@ namespace gui
 			Image img;
 			PointF pos;
 			float zoomFactor;
+			// invalidates decodes that finish after the page was flipped again
+			std::shared_ptr<std::atomic<int>> request;
 
 			void updatePos(const PointF&);
 
@@ -96,17 +99,21 @@ namespace gui
 		// title, links, subTitle
 		void add(const String&, const Links&, const String&);
 
+		// the first page is only decoded once the credits are shown
 		void init();
 
 		void paint(Graphics&) override;
 
 		void resized() override;
+
+		void visibilityChanged() override;
 	private:
 		std::vector<Page> pages;
 		Label titleLabel;
 		Button previous, next;
 		Entry entry;
 		int idx;
+		bool pageLoaded;
 
 		void flipPage();
 	};
@@ -4,16 +4,17 @@ namespace gui
 {
 	// Visualizer
 
-	EnvelopeFollowerEditor::Visualizer::Visualizer(Utils& u, const EnvFol& envelopeFollower) :
+	EnvelopeFollowerEditor::Visualizer::Visualizer(Utils& u) :
 		Comp(u),
 		img(),
 		y0(0.f)
 	{
 		setOpaque(true);
-		add(Callback([&, &envFol = envelopeFollower]()
+		addEvt([&](const evt::Type type, const void* stuff)
 			{
-				if (!img.isValid())
+				if (type != evt::Type::TelemetryUpdated || !img.isValid())
 					return;
+				const auto& record = *static_cast<const dsp::Telemetry::Record*>(stuff);
 				const auto thicc = utils.thicc;
 				const auto valSize = std::round(thicc);
 				const auto valSizeInt = static_cast<int>(valSize);
@@ -24,7 +25,7 @@ namespace gui
 				const auto x = w - valSize;
 				setCol(g, CID::Bg);
 				g.fillRect(x, 0.f, valSize, h);
-				const auto meter = static_cast<float>(envFol.getMeter());
+				const auto meter = record.envFolMod;
 				const auto y1 = math::limit(0.f, h, h - meter * h);
 				setCol(g, CID::Mod);
 				const auto y = std::min(y0, y1);
@@ -32,7 +33,7 @@ namespace gui
 				g.fillRect(rect.toNearestInt());
 				y0 = y1;
 				repaint();
-			}, 0, cbFPS::k60, true));
+			});
 	}
 
 	void EnvelopeFollowerEditor::Visualizer::resized()
@@ -55,10 +56,10 @@ namespace gui
 
 	// Editor
 
-	EnvelopeFollowerEditor::EnvelopeFollowerEditor(const EnvFol& envFol, Utils& u,
+	EnvelopeFollowerEditor::EnvelopeFollowerEditor(Utils& u,
 		PID pGain, PID pAttack, PID pDecay, PID pSmooth) :
 		Comp(u),
-		visualizer(u, envFol),
+		visualizer(u),
 		title(u), gainLabel(u), attackLabel(u), decayLabel(u), smoothLabel(u),
 		gain(u), attack(u), decay(u), smooth(u),
 		gainMod(u), attackMod(u), decayMod(u), smoothMod(u),
@@ -1,19 +1,17 @@
 #pragma once
 #include "Knob.h"
 #include "ButtonRandomizer.h"
-#include "../audio/dsp/EnvelopeFollower.h"
 
 namespace gui
 {
 	class EnvelopeFollowerEditor :
 		public Comp
 	{
-		using EnvFol = dsp::EnvelopeFollower;
-
+		// draws the envelope follower's telemetry
 		struct Visualizer :
 			public Comp
 		{
-			Visualizer(Utils&, const EnvFol&);
+			Visualizer(Utils&);
 
 			void resized() override;
 
@@ -24,8 +22,8 @@ namespace gui
 		};
 
 	public:
-		// envFol, u, gain, attack, decay, smooth
-		EnvelopeFollowerEditor(const EnvFol&, Utils&,
+		// u, gain, attack, decay, smooth
+		EnvelopeFollowerEditor(Utils&,
 			PID, PID, PID, PID);
 
 		void paint(Graphics&) override;
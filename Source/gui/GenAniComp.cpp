@@ -4,15 +4,22 @@ namespace gui
 {
 	// GenAniComp
 
+	File getGenAniFile(Utils& utils)
+	{
+		const auto& user = utils.getProps();
+		return user.getFile().getParentDirectory().getChildFile("genani.png");
+	}
+
 	GenAniComp::GenAniComp(Utils& u, String&& _tooltip) :
 		Comp(u, _tooltip),
 		img(),
-		onResize([]() {}),
+		worker(Image::PixelFormat::RGB),
 		active(utils.getProps().getBoolValue("genaniactive", true)),
 		mode(utils.getProps().getIntValue("genanimode", 0)),
 		numModes(1)
 	{
 		setOpaque(true);
+		loadImage();
 	}
 
 	GenAniComp::~GenAniComp()
@@ -20,49 +27,21 @@ namespace gui
 		saveImage();
 	}
 
-	void GenAniComp::init()
-	{
-		callbacks[0].active = active;
-	}
-
 	void GenAniComp::paint(Graphics& g)
 	{
+		if (!img.isValid())
+			return g.fillAll(Colour(0xff000000));
 		g.drawImageAt(img, 0, 0);
 	}
 
-	bool GenAniComp::loadImage()
+	void GenAniComp::loadImage()
 	{
-		auto& user = utils.getProps();
-		const auto& file = user.getFile();
-		const auto directory = file.getParentDirectory();
-		const auto path = directory.getFullPathName() + File::getSeparatorString() + "genani.png";
-		const auto findFiles = File::TypesOfFileToFind::findFiles;
-		const auto wildCard = "*.png";
-		for (auto f : directory.findChildFiles(findFiles, true, wildCard))
-		{
-			if (f.getFileName() == "genani.png")
-			{
-				const auto nImg = juce::ImageFileFormat::loadFrom(f);
-				if (nImg.isValid())
-				{
-					img = nImg;
-					return true;
-				}
-			}
-		}
-		return false;
+		worker.load(getGenAniFile(utils));
 	}
 
 	void GenAniComp::saveImage()
 	{
-		auto& user = utils.getProps();
-		const auto directory = user.getFile().getParentDirectory();
-		auto file = directory.getChildFile("genani.png");
-		if (file.existsAsFile())
-			file.deleteFile();
-		juce::FileOutputStream stream(file);
-		juce::PNGImageFormat pngWriter;
-		pngWriter.writeImageToStream(img, stream);
+		worker.save(getGenAniFile(utils));
 	}
 
 	void GenAniComp::mouseUp(const Mouse& mouse)
@@ -76,7 +55,6 @@ namespace gui
 			return;
 		}
 		active = !active;
-		callbacks[0].active = active;
 		if (!active)
 			saveImage();
 		auto& user = utils.getProps();
@@ -85,95 +63,100 @@ namespace gui
 
 	void GenAniComp::resized()
 	{
-		if (img.isValid())
-			img = img.rescaled(getWidth(), getHeight(), Graphics::lowResamplingQuality);
-		else
-		{
-			if (!loadImage())
-				img = Image(Image::PixelFormat::RGB, getWidth(), getHeight(), true);
-		}
-		fixStupidJUCEImageThingie(img);
-		onResize();
+		worker.setSize(getWidth(), getHeight());
 	}
 
 	// H&M Ani
 
 	GenAniGrowTrees::GenAniGrowTrees(Utils& u) :
 		GenAniComp(u, "Get mesmerized by this procedural stuff! (CTRL+Click to switch mode)"),
+		canvas(),
 		rand(),
 		col(juce::uint8(rand.nextInt()), juce::uint8(rand.nextInt()), juce::uint8(rand.nextInt())),
 		pos(),
 		angle(0.f),
-		alphaDownCount(0)
+		alphaDownCount(0),
+		thicc(1.f),
+		width(0),
+		height(0)
 	{
 		numModes = kNumModes;
 
-		onResize = [&]()
-			{
-				const auto width = static_cast<float>(getWidth());
-				const auto height = static_cast<float>(getHeight());
-				pos.setXY(rand.nextFloat() * width, height);
-			};
-
 		const auto fps = cbFPS::k7_5;
-		const auto speed = msToInc(AniLengthMs, fps);
 
-		add(Callback([&, speed]()
+		add(Callback([&]()
 			{
-				if (!img.isValid())
+				if (worker.fetch(img))
+					repaint();
+				if (!active || worker.isBusy())
 					return;
+				worker.render([this, m = mode, t = utils.thicc](Image& c)
+				{
+					render(c, m, t);
+				});
+			}, 0, fps, true, Callback::Priority::Low));
+	}
 
-				Graphics g{ img };
+	GenAniGrowTrees::~GenAniGrowTrees()
+	{
+		worker.wait();
+	}
 
-				switch (mode)
-				{
-				case kTree:
-					treeProcess(g);
-					break;
-				case kTech:
-					techProcess(g);
-					break;
-				default:
-					treeProcess(g);
-					break;
-				}
-				repaint();
-			}, 0, fps, false));
-
-		init();
+	void GenAniGrowTrees::render(Image& _canvas, int _mode, float _thicc)
+	{
+		canvas = _canvas;
+		thicc = _thicc;
+		if (canvas.getWidth() != width || canvas.getHeight() != height)
+		{
+			width = canvas.getWidth();
+			height = canvas.getHeight();
+			pos.setXY(rand.nextFloat() * static_cast<float>(width), static_cast<float>(height));
+		}
+
+		Graphics g{ canvas };
+
+		switch (_mode)
+		{
+		case kTree:
+			treeProcess(g);
+			break;
+		case kTech:
+			techProcess(g);
+			break;
+		default:
+			treeProcess(g);
+			break;
+		}
 	}
 
 	void GenAniGrowTrees::treeProcess(Graphics& g)
 	{
-		const auto width = static_cast<float>(getWidth());
-		const auto height = static_cast<float>(getHeight());
+		const auto widthF = static_cast<float>(width);
+		const auto heightF = static_cast<float>(height);
 
-		const auto length = 1.f + rand.nextFloat() * 2.f * utils.thicc;
+		const auto length = 1.f + rand.nextFloat() * 2.f * thicc;
 		const auto line = LineF::fromStartAndAngle(pos, length, angle + PiQuart - rand.nextFloat() * PiHalf);
 		const auto end = line.getEnd();
 
 		g.setColour(col);
-		const auto thicc = 1.f + rand.nextFloat() * 2.f * utils.thicc;
-		g.drawLine(line, thicc);
+		const auto lineThicc = 1.f + rand.nextFloat() * 2.f * thicc;
+		g.drawLine(line, lineThicc);
 
 		pos = end;
 
 		const bool triggerBranch = rand.nextFloat() < MutationLikelyness;
 
 		if (pos.y <= 0.f || triggerBranch)
-			startNewBranch(width, height, 3.6f, .7f);
+			startNewBranch(widthF, heightF, 3.6f, .7f);
 
 		++alphaDownCount;
 		if (alphaDownCount >= 1 << MutationTime)
-			mutate(width, height);
+			mutate(widthF, heightF);
 	}
 
 	void GenAniGrowTrees::techProcess(Graphics& g)
 	{
-		const auto width = getWidth();
-		const auto height = getHeight();
-
-		const auto flipx = [width](int x)
+		const auto flipx = [width = width](int x)
 			{
 				if (x < 0)
 					return x + width;
@@ -181,7 +164,7 @@ namespace gui
 					return x - width;
 				return x;
 			};
-		const auto flipy = [height](int y)
+		const auto flipy = [height = height](int y)
 			{
 				if (y < 0)
 					return y + height;
@@ -213,7 +196,7 @@ namespace gui
 		{
 			const auto x = rand.nextInt(width);
 			const auto y = rand.nextInt(height);
-			const auto pxl = img.getPixelAt(x, y);
+			const auto pxl = canvas.getPixelAt(x, y);
 			if (pxl.getBrightness() > .1f)
 			{
 				++numSpotsFound;
@@ -257,7 +240,7 @@ namespace gui
 		for (auto y = 0; y < height; ++y)
 			for (auto x = 0; x < width; ++x)
 			{
-				const auto pxl = img.getPixelAt(x, y);
+				const auto pxl = canvas.getPixelAt(x, y);
 				brightness += pxl.getBrightness();
 			}
 		brightness /= width * height;
@@ -284,7 +267,7 @@ namespace gui
 			const auto rBias = math::tanhApprox(gravity * rand.nextFloat());
 			const auto y0 = minY + (height - minY) * rBias * rBias;
 			pos.setXY(x0, y0);
-			auto pxl = img.getPixelAt(static_cast<int>(pos.x), static_cast<int>(pos.y));
+			auto pxl = canvas.getPixelAt(static_cast<int>(pos.x), static_cast<int>(pos.y));
 			if (pxl.getPerceivedBrightness() > 1.f - latchLikelyness)
 			{
 				const auto hue = col.getHue() + .1f * (rand.nextFloat() - .5f);
@@ -301,19 +284,19 @@ namespace gui
 	{
 		Colour black(0xff000000);
 
-		const auto h = static_cast<float>(img.getHeight());
+		const auto h = static_cast<float>(canvas.getHeight());
 		const auto hInv = 1.f / h;
 		const auto valRange = valBtm - valTop;
-		for (auto y = 0; y < img.getHeight(); ++y)
+		for (auto y = 0; y < canvas.getHeight(); ++y)
 		{
 			const auto yF = static_cast<float>(y);
 			const auto yR = yF * hInv;
 			const auto val = valTop + yR * valRange;
-			for (auto x = 0; x < img.getWidth(); ++x)
+			for (auto x = 0; x < canvas.getWidth(); ++x)
 			{
-				auto pxl = img.getPixelAt(x, y);
+				auto pxl = canvas.getPixelAt(x, y);
 				pxl = pxl.interpolatedWith(black, val);
-				img.setPixelAt(x, y, pxl);
+				canvas.setPixelAt(x, y, pxl);
 			}
 		}
 
@@ -322,19 +305,19 @@ namespace gui
 	void GenAniGrowTrees::brighten(float valTop, float valBtm) noexcept
 	{
 		Colour white(0xffffffff);
-		const auto h = static_cast<float>(img.getHeight());
+		const auto h = static_cast<float>(canvas.getHeight());
 		const auto hInv = 1.f / h;
 		const auto valRange = valBtm - valTop;
-		for (auto y = 0; y < img.getHeight(); ++y)
+		for (auto y = 0; y < canvas.getHeight(); ++y)
 		{
 			const auto yF = static_cast<float>(y);
 			const auto yR = yF * hInv;
 			const auto val = valTop + yR * valRange;
-			for (auto x = 0; x < img.getWidth(); ++x)
+			for (auto x = 0; x < canvas.getWidth(); ++x)
 			{
-				auto pxl = img.getPixelAt(x, y);
+				auto pxl = canvas.getPixelAt(x, y);
 				pxl = pxl.interpolatedWith(white, val);
-				img.setPixelAt(x, y, pxl);
+				canvas.setPixelAt(x, y, pxl);
 			}
 		}
 	}
@@ -376,7 +359,7 @@ namespace gui
 		{
 			auto xx = darkenPos.x + mat[j].x;
 			auto yy = darkenPos.y + mat[j].y;
-			img.setPixelAt(xx, yy, Colour(0xff000000));
+			canvas.setPixelAt(xx, yy, Colour(0xff000000));
 		}
 	}
 	// TREE PROCESS END
@@ -1,5 +1,6 @@
 #pragma once
 #include "Comp.h"
+#include "RenderWorker.h"
 
 namespace gui
 {
@@ -11,12 +12,12 @@ namespace gui
 
 		~GenAniComp();
 
-		void init();
-
 		void paint(Graphics&) override;
 
-		bool loadImage();
+		// the saved image is decoded on the render worker and continued from there
+		void loadImage();
 
+		// encodes the canvas on the render worker
 		void saveImage();
 
 		void mouseUp(const Mouse&) override;
@@ -24,7 +25,7 @@ namespace gui
 		void resized() override;
 	protected:
 		Image img;
-		std::function<void()> onResize;
+		RenderWorker worker;
 		int mode, numModes;
 		bool active;
 	};
@@ -40,16 +41,25 @@ namespace gui
 		//
 
 		GenAniGrowTrees(Utils&);
+
+		~GenAniGrowTrees();
 	private:
+		// everything below is only touched by the render worker
+		Image canvas;
 		Random rand;
 		// TREE VARIABLES
 		juce::Colour col;
 		PointF pos;
 		float angle;
 		int alphaDownCount;
+		float thicc;
+		int width, height;
 		// TECH VARIABLES
 		//
 
+		// canvas, mode, thicc
+		void render(Image&, int, float);
+
 		void treeProcess(Graphics&);
 
 		void techProcess(Graphics&);
@@ -333,30 +333,6 @@ namespace gui
 	void IOEditor::initVoiceGrid()
 	{
 		addAndMakeVisible(voiceGrid);
-		voiceGrid.init([&](VoiceGrid<dsp::AutoMPE::VoicesSize>::Voices& voices)
-		{
-			bool updated = false;
-			
-			const auto& polyParam = utils.audioProcessor.params(PID::Polyphony);
-			const auto poly = static_cast<int>(std::round(polyParam.getValModDenorm()));
-			if (voiceGrid.poly != poly)
-			{
-				updated = true;
-				voiceGrid.poly = poly;
-			}
-
-			const auto& pp = utils.audioProcessor.pluginProcessor.parallelProcessor;
-			for (auto i = 0; i < voiceGrid.poly; ++i)
-			{
-				const auto active = !pp.isSleepy(i);
-				if (voices[i] != active)
-				{
-					updated = true;
-					voices[i] = active;
-				}
-			}
-			return updated;
-		});
 	}
 
 	void IOEditor::initButtons()
@@ -10,53 +10,6 @@ namespace gui
 		return settingsDirectory.getChildFile("Patches");
 	}
 
-	Int64 getDirectorySize(const File& directory)
-	{
-		const auto wildcard = "*.txt";
-		const auto type = File::TypesOfFileToFind::findFiles;
-		const RangedDirectoryIterator iterator
-		(
-			directory,
-			true,
-			wildcard,
-			type
-		);
-
-		Int64 size = 0;
-		for (const auto& it : iterator)
-			size += it.getFileSize();
-		return size;
-	}
-
-	String generateWildcard(const String& filter)
-	{
-		if (filter.isEmpty())
-			return "*.txt";
-		String wildcard("*");
-		wildcard += filter + "*.txt";
-		const char charactersToReplace[] =
-		{
-			' ', '.', '-', '_', '(', ')', '\'', '\"', '!', '?', ',', ';', ':', '=', '+',
-			'/', '\\', '|', '~', '`', '@', '#', '$', '%', '^', '&'
-		};
-		for (const char c : charactersToReplace)
-			wildcard = wildcard.replaceCharacter(c, '*');
-		return wildcard;
-	}
-
-	bool isInAuthor(const String& author, const String& filter)
-	{
-		if (filter.isEmpty())
-			return true;
-		const auto authorLC = author.toLowerCase();
-		const auto filterLC = filter.toLowerCase();
-		const auto words = StringArray::fromTokens(filterLC, " ", "");
-		for (const auto& word : words)
-			if (authorLC.contains(word))
-				return true;
-		return false;
-	}
-
 	namespace patch
 	{
 		// Patch
@@ -173,10 +126,14 @@ namespace gui
 			},
 			selected(nullptr),
 			scrollBar(u),
-			directorySize(getDirectorySize(getPatchesDirectory(u))),
+			index(),
+			filtered(),
+			indexVersion(index->getVersion()),
+			watching(false),
 			filterName(""),
 			filterAuthor("")
 		{
+			index->setDirectory(getPatchesDirectory(u));
 			layout.init
 			(
 				{ 13, 1 },
@@ -210,17 +167,29 @@ namespace gui
 
 			Comp::add(Callback([&]()
 				{
-					if (!isShowing())
+					// the index only scans while a browser shows it
+					const auto showing = isShowing();
+					if (watching != showing)
+					{
+						watching = showing;
+						index->watch(watching);
+					}
+					if (!showing)
 						return;
-					const auto patchesDirectory = getPatchesDirectory(u);
-					const auto nSize = getDirectorySize(patchesDirectory);
-					if (directorySize == nSize)
+					const auto nVersion = index->getVersion();
+					if (indexVersion == nVersion)
 						return;
-					directorySize = nSize;
+					indexVersion = nVersion;
 					update();
 					resized();
 					repaint();
-				}, 0, cbFPS::k_1_875, true));
+				}, 0, cbFPS::k_1_875, true, Callback::Priority::Low));
+		}
+
+		Patches::~Patches()
+		{
+			if (watching)
+				index->watch(false);
 		}
 
 		void Patches::resized()
@@ -263,18 +232,9 @@ namespace gui
 
 		void Patches::update()
 		{
-			const auto patchesDirectory = getPatchesDirectory(utils);
-			const auto wildcard = generateWildcard(filterName);
-			const auto type = File::TypesOfFileToFind::findFiles;
-			const RangedDirectoryIterator iterator
-			(
-				patchesDirectory,
-				true,
-				wildcard,
-				type
-			);
+			index->filter(filterName, filterAuthor, filtered);
 
-			const auto numFiles = patchesDirectory.getNumberOfChildFiles(type, wildcard);
+			const auto numFiles = static_cast<int>(filtered.size());
 			if (numFiles == 0)
 			{
 				scrollBar.numFiles = 1;
@@ -291,62 +251,38 @@ namespace gui
 			if (scrollBar.viewIdx >= scrollBar.numFiles)
 				scrollBar.viewIdx = scrollBar.numFiles - 1;
 
-			auto idx = -scrollBar.viewIdx;
-			for (const auto& it : iterator)
+			auto idx = 0;
+			for (; idx < NumPatches; ++idx)
 			{
-				if (idx >= 0)
-				{
-					if (idx < NumPatches)
-					{
-						const auto file = it.getFile();
-						updateAdd(file, idx);
-					}
-				}
-				++idx;
+				const auto f = scrollBar.viewIdx + idx;
+				if (f >= numFiles)
+					break;
+				updateAdd(filtered[f], idx);
 			}
 			for (; idx < NumPatches; ++idx)
 				patches[idx].deactivate();
 		}
 
-		void Patches::updateAdd(const File& file, int i)
+		void Patches::updateAdd(const Index::Entry& entry, int i)
 		{
-			const auto state = ValueTree::fromXml(file.loadFileAsString());
-			auto name = file.getFileName();
-			name = name.substring(0, name.lastIndexOf("."));
-			const auto author = state.getProperty("author", "");
-			if (isInAuthor(author, filterAuthor))
-			{
-				patches[i].activate(name, author, file);
-				patches[i].buttonLoad.onClick = [&, i](const Mouse&)
-					{
-						selected = &patches[i];
-						const auto& file = patches[i].file;
-						const auto vt = ValueTree::fromXml(file.loadFileAsString());
-						if (!vt.isValid())
-							return;
-						auto& state = utils.audioProcessor.state;
-						state.state = vt;
-						utils.audioProcessor.params.loadPatch(state);
-						utils.audioProcessor.pluginProcessor.loadPatch(state);
-					};
-				patches[i].buttonDelete.onClick = [&, i](const Mouse&)
-					{
-						if (patches[i].author == "factory")
-							return;
-						const auto file = patches[i].file;
-						file.deleteFile();
-						const auto directory = getPatchesDirectory(utils);
-						directorySize = getDirectorySize(directory);
-						patches[i].deactivate();
-						update();
-						resized();
-						repaint();
-					};
-			}
-			else
-			{
-				patches[i].deactivate();
-			}
+			patches[i].activate(entry.name, entry.author, entry.file);
+			patches[i].buttonLoad.onClick = [&, i](const Mouse&)
+				{
+					selected = &patches[i];
+					load(patches[i].file);
+				};
+			patches[i].buttonDelete.onClick = [&, i](const Mouse&)
+				{
+					if (patches[i].author == "factory")
+						return;
+					const auto file = patches[i].file;
+					file.deleteFile();
+					// the index drops it with its next scan
+					index->refresh();
+					patches[i].deactivate();
+					resized();
+					repaint();
+				};
 		}
 
 		const Patch& Patches::operator[](int i) const noexcept
@@ -393,14 +329,26 @@ namespace gui
 					idx = 0;
 			}
 			selected = &patches[idx];
-			const auto& file = patches[idx].file;
-			const auto vt = ValueTree::fromXml(file.loadFileAsString());
+			// a slot without a patch has no file either, which would mean the init patch
+			if (selected->isVisible())
+				load(selected->file);
+		}
+
+		void Patches::load(const File& file)
+		{
+			auto& processor = utils.audioProcessor;
+			const auto vt = file == File() ?
+				processor.getInitPatch().createCopy() :
+				ValueTree::fromXml(file.loadFileAsString());
 			if (!vt.isValid())
 				return;
-			auto& state = utils.audioProcessor.state;
-			state.state = vt;
-			utils.audioProcessor.params.loadPatch(state);
-			utils.audioProcessor.pluginProcessor.loadPatch(state);
+			processor.loadPatchStaged([&processor, vt]()
+			{
+				auto& state = processor.state;
+				state.state = vt;
+				processor.params.loadPatch(state);
+				processor.pluginProcessor.loadPatch(state);
+			});
 		}
 
 		// ButtonSavePatch
@@ -432,6 +380,7 @@ namespace gui
 					if (result.failed())
 						return;
 					file.replaceWithText(vt.toXmlString());
+					juce::SharedResourcePointer<Index>()->refresh();
 				};
 
 			makePaintButton(*this, [](Graphics& g, const Button& b)
@@ -1,5 +1,6 @@
 #pragma once
 #include "TextEditor.h"
+#include "PatchIndex.h"
 #include "../arch/State.h"
 
 namespace gui
@@ -43,6 +44,8 @@ namespace gui
 		{
 			Patches(Utils&);
 
+			~Patches() override;
+
 			void resized() override;
 
 			// name, author
@@ -50,8 +53,8 @@ namespace gui
 
 			void update();
 
-			// file, i
-			void updateAdd(const File&, int);
+			// entry, i
+			void updateAdd(const Index::Entry&, int);
 
 			const Patch& operator[](int) const noexcept;
 
@@ -71,8 +74,14 @@ namespace gui
 			std::array<Patch, NumPatches> patches;
 			Patch* selected;
 			ScrollBar scrollBar;
-			Int64 directorySize;
+			juce::SharedResourcePointer<Index> index;
+			Index::Entries filtered;
+			uint32_t indexVersion;
+			bool watching;
 			String filterName, filterAuthor;
+
+			// file, stages the patch on the processor, no file means the init patch
+			void load(const File&);
 		};
 
 		struct ButtonSavePatch :
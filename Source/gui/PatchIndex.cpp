@@ -0,0 +1,206 @@
+#include "PatchIndex.h"
+
+namespace gui
+{
+	String generateWildcard(const String& filter)
+	{
+		if (filter.isEmpty())
+			return "*.txt";
+		String wildcard("*");
+		wildcard += filter + "*.txt";
+		const char charactersToReplace[] =
+		{
+			' ', '.', '-', '_', '(', ')', '\'', '\"', '!', '?', ',', ';', ':', '=', '+',
+			'/', '\\', '|', '~', '`', '@', '#', '$', '%', '^', '&'
+		};
+		for (const char c : charactersToReplace)
+			wildcard = wildcard.replaceCharacter(c, '*');
+		return wildcard;
+	}
+
+	bool isInAuthor(const String& author, const String& filter)
+	{
+		if (filter.isEmpty())
+			return true;
+		const auto authorLC = author.toLowerCase();
+		const auto filterLC = filter.toLowerCase();
+		const auto words = StringArray::fromTokens(filterLC, " ", "");
+		for (const auto& word : words)
+			if (authorLC.contains(word))
+				return true;
+		return false;
+	}
+
+	namespace patch
+	{
+		Index::Index() :
+			juce::Thread("Patch Index"),
+			directory(),
+			mutex(),
+			entries(),
+			version(0),
+			numWatchers(0)
+		{
+			startThread(juce::Thread::Priority::background);
+		}
+
+		Index::~Index()
+		{
+			stopThread(PollMs * 2);
+		}
+
+		void Index::setDirectory(const File& nDirectory)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (directory == nDirectory)
+					return;
+				directory = nDirectory;
+			}
+			notify();
+		}
+
+		void Index::watch(bool e)
+		{
+			if (e)
+			{
+				++numWatchers;
+				notify();
+			}
+			else
+				--numWatchers;
+		}
+
+		void Index::refresh()
+		{
+			notify();
+		}
+
+		Index::Entry Index::makeInitEntry()
+		{
+			Entry entry;
+			entry.name = " init ";
+			entry.author = "factory";
+			entry.size = 0;
+			return entry;
+		}
+
+		void Index::filter(const String& filterName, const String& filterAuthor, Entries& dest) const
+		{
+			const auto wildcard = generateWildcard(filterName);
+			dest.clear();
+			auto init = makeInitEntry();
+			if ((init.name + ".txt").matchesWildcard(wildcard, true))
+				if (isInAuthor(init.author, filterAuthor))
+					dest.push_back(std::move(init));
+			std::lock_guard<std::mutex> lock(mutex);
+			for (const auto& entry : entries)
+				if (entry.file.getFileName().matchesWildcard(wildcard, true))
+					if (isInAuthor(entry.author, filterAuthor))
+						dest.push_back(entry);
+		}
+
+		uint32_t Index::getVersion() const noexcept
+		{
+			return version.load();
+		}
+
+		void Index::run()
+		{
+			auto pollMs = PollMs;
+			while (!threadShouldExit())
+			{
+				if (numWatchers.load() == 0)
+				{
+					// the next watcher or refresh notifies
+					wait(-1);
+					pollMs = PollMs;
+					continue;
+				}
+				if (scan())
+				{
+					version.fetch_add(1);
+					pollMs = PollMs;
+				}
+				else
+					pollMs = std::min(pollMs * 2, PollMsMax);
+				if (wait(pollMs))
+					pollMs = PollMs;
+			}
+		}
+
+		bool Index::scan()
+		{
+			// only this thread writes entries, so reading them here needs no lock
+			File dir;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				dir = directory;
+			}
+			if (dir == File())
+				return false;
+			Entries nEntries;
+			nEntries.reserve(entries.size());
+
+			const auto type = File::TypesOfFileToFind::findFiles;
+			const RangedDirectoryIterator iterator
+			(
+				dir,
+				true,
+				"*.txt",
+				type
+			);
+			for (const auto& it : iterator)
+			{
+				if (threadShouldExit())
+					return false;
+				Entry entry;
+				entry.file = it.getFile();
+				entry.modified = it.getModificationTime();
+				entry.size = it.getFileSize();
+				nEntries.push_back(entry);
+			}
+
+			std::sort(nEntries.begin(), nEntries.end(), [](const Entry& a, const Entry& b)
+				{
+					return a.file < b.file;
+				});
+
+			// both are sorted by path, so known files are found by walking along
+			auto changed = nEntries.size() != entries.size();
+			size_t e = 0;
+			for (auto& entry : nEntries)
+			{
+				while (e < entries.size() && entries[e].file < entry.file)
+					++e;
+				if (e < entries.size() && entries[e].file == entry.file)
+				{
+					const auto& known = entries[e];
+					if (known.modified == entry.modified && known.size == entry.size)
+					{
+						entry = known;
+						continue;
+					}
+				}
+
+				changed = true;
+				const auto name = entry.file.getFileName();
+				entry.name = name.substring(0, name.lastIndexOf("."));
+				// the author and tags are attributes of the outer element, so the rest is skipped
+				juce::XmlDocument doc(entry.file);
+				const auto xml = doc.getDocumentElement(true);
+				if (xml != nullptr)
+				{
+					entry.author = xml->getStringAttribute("author");
+					entry.tags = xml->getStringAttribute("tags");
+				}
+			}
+
+			if (!changed)
+				return false;
+			std::lock_guard<std::mutex> lock(mutex);
+			entries = std::move(nEntries);
+			return true;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+#include "Using.h"
+#include <mutex>
+
+namespace gui
+{
+	// filter
+	String generateWildcard(const String&);
+
+	// author, filter
+	bool isInAuthor(const String&, const String&);
+
+	namespace patch
+	{
+		// every patch of the patches folder, scanned on a background thread.
+		// the thread diffs file times and sizes to keep it current and only rereads
+		// changed files, so that filtering and scrolling never touch the disk.
+		// all instances share one index through a SharedResourcePointer. it only scans while
+		// a browser shows it, and polls less often the longer nothing changes
+		class Index :
+			public juce::Thread
+		{
+			static constexpr int PollMs = 1000;
+			static constexpr int PollMsMax = 16000;
+		public:
+			struct Entry
+			{
+				String name, author, tags;
+				File file;
+				Time modified;
+				Int64 size;
+			};
+			using Entries = std::vector<Entry>;
+
+			// the init patch lives in memory, so its entry has no file
+			static Entry makeInitEntry();
+
+			Index();
+
+			~Index() override;
+
+			// directory
+			void setDirectory(const File&);
+
+			// watching, scans run while any browser watches
+			void watch(bool);
+
+			// wakes the scan up, so that changes show up without waiting for the next poll
+			void refresh();
+
+			// filterName, filterAuthor, dest
+			void filter(const String&, const String&, Entries&) const;
+
+			// increments whenever an entry got added, changed or removed
+			uint32_t getVersion() const noexcept;
+
+			void run() override;
+		private:
+			File directory;
+			mutable std::mutex mutex;
+			Entries entries;
+			std::atomic<uint32_t> version;
+			std::atomic<int> numWatchers;
+
+			// returns true if any entry changed
+			bool scan();
+		};
+	}
+}
\ No newline at end of file
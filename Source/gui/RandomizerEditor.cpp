@@ -4,16 +4,17 @@ namespace gui
 {
 	// Visualizer
 
-	RandomizerEditor::Visualizer::Visualizer(Utils& u, const RandMod& randMod) :
+	RandomizerEditor::Visualizer::Visualizer(Utils& u) :
 		Comp(u),
 		img(),
 		y0(0.f)
 	{
 		setOpaque(true);
-		add(Callback([&, &rand = randMod]()
+		addEvt([&](const evt::Type type, const void* stuff)
 			{
-				if (!img.isValid())
+				if (type != evt::Type::TelemetryUpdated || !img.isValid())
 					return;
+				const auto& record = *static_cast<const dsp::Telemetry::Record*>(stuff);
 				const auto thicc = utils.thicc;
 				const auto valSize = std::round(thicc);
 				const auto valSizeInt = static_cast<int>(valSize);
@@ -24,7 +25,7 @@ namespace gui
 				const auto x = w - valSize;
 				setCol(g, CID::Bg);
 				g.fillRect(x, 0.f, valSize, h);
-				const auto meter = rand.getMeter();
+				const auto meter = record.randMod;
 				const auto y1 = math::limit(0.f, h, h - meter * h);
 				setCol(g, CID::Mod);
 				const auto y = std::min(y0, y1);
@@ -32,7 +33,7 @@ namespace gui
 				g.fillRect(rect.toNearestInt());
 				y0 = y1;
 				repaint();
-			}, 0, cbFPS::k60, true));
+			});
 	}
 
 	void RandomizerEditor::Visualizer::resized()
@@ -55,10 +56,10 @@ namespace gui
 
 	// Editor
 
-	RandomizerEditor::RandomizerEditor(const RandMod& randMod, Utils& u,
+	RandomizerEditor::RandomizerEditor(Utils& u,
 		PID pRateSync, PID pSmooth, PID pComplex, PID pDropout) :
 		Comp(u),
-		visualizer(u, randMod),
+		visualizer(u),
 		title(u), rateSyncLabel(u), smoothLabel(u), complexLabel(u), dropoutLabel(u),
 		rateSync(u), smooth(u), complex(u), dropout(u),
 		rateSyncMod(u), smoothMod(u), complexMod(u), dropoutMod(u),
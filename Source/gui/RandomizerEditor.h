@@ -1,6 +1,5 @@
 #pragma once
 #include "Knob.h"
-#include "../audio/dsp/Randomizer.h"
 #include "ButtonRandomizer.h"
 
 namespace gui
@@ -8,12 +7,11 @@ namespace gui
 	struct RandomizerEditor :
 		public Comp
 	{
-		using RandMod = dsp::Randomizer;
-
+		// draws the randomizer's telemetry
 		struct Visualizer :
 			public Comp
 		{
-			Visualizer(Utils&, const RandMod&);
+			Visualizer(Utils&);
 
 			void resized() override;
 
@@ -23,8 +21,8 @@ namespace gui
 			float y0;
 		};
 
-		// randMod, u, rateSync, smooth, complex, dropout
-		RandomizerEditor(const RandMod&, Utils&,
+		// u, rateSync, smooth, complex, dropout
+		RandomizerEditor(Utils&,
 			PID, PID, PID, PID);
 
 		void paint(Graphics&);
@@ -0,0 +1,164 @@
+#include "RenderWorker.h"
+
+namespace gui
+{
+	// Pool
+
+	RenderWorker::Pool::Pool() :
+		ThreadPool(1, 0, juce::Thread::Priority::low)
+	{}
+
+	RenderWorker::Pool::~Pool()
+	{
+		// the last editor just closed, let its png saves finish before jobs get removed
+		for (auto i = 0; i < 100 && getNumJobs() != 0; ++i)
+			juce::Thread::sleep(10);
+	}
+
+	// Shared
+
+	RenderWorker::Shared::Shared(Image::PixelFormat _format) :
+		mutex(),
+		canvas(),
+		spare(),
+		back(),
+		format(_format),
+		numRenders(0),
+		ready(false)
+	{}
+
+	void RenderWorker::Shared::resize(int w, int h)
+	{
+		if (w <= 0 || h <= 0)
+			return;
+		if (!canvas.isValid())
+		{
+			canvas = Image(format, w, h, true, juce::SoftwareImageType());
+			return;
+		}
+		if (canvas.getWidth() == w && canvas.getHeight() == h)
+			return;
+		canvas = canvas.rescaled(w, h, Graphics::lowResamplingQuality);
+	}
+
+	void RenderWorker::Shared::publish()
+	{
+		if (!canvas.isValid())
+			return;
+		const auto w = canvas.getWidth();
+		const auto h = canvas.getHeight();
+		if (!spare.isValid() || spare.getWidth() != w || spare.getHeight() != h || spare.getFormat() != canvas.getFormat())
+			spare = Image(canvas.getFormat(), w, h, false, juce::SoftwareImageType());
+		{
+			const Image::BitmapData src(canvas, Image::BitmapData::readOnly);
+			Image::BitmapData dest(spare, Image::BitmapData::writeOnly);
+			const auto numBytes = static_cast<size_t>(w * src.pixelStride);
+			for (auto y = 0; y < h; ++y)
+				std::memcpy(dest.getLinePointer(y), src.getLinePointer(y), numBytes);
+		}
+		const std::lock_guard<std::mutex> lock(mutex);
+		std::swap(spare, back);
+		ready = true;
+	}
+
+	// RenderWorker
+
+	RenderWorker::RenderWorker(Image::PixelFormat format) :
+		pool(),
+		shared(std::make_shared<Shared>(format)),
+		width(0),
+		height(0)
+	{}
+
+	RenderWorker::~RenderWorker()
+	{
+		wait();
+	}
+
+	void RenderWorker::render(RenderFunc&& func)
+	{
+		++shared->numRenders;
+		pool->addJob([s = shared, f = std::move(func)]()
+		{
+			if (s->canvas.isValid())
+			{
+				f(s->canvas);
+				s->publish();
+			}
+			--s->numRenders;
+		});
+	}
+
+	void RenderWorker::setSize(int w, int h)
+	{
+		width = w;
+		height = h;
+		pool->addJob([s = shared, w, h]()
+		{
+			s->resize(w, h);
+			s->publish();
+		});
+	}
+
+	bool RenderWorker::hasSize(int w, int h) const noexcept
+	{
+		return width == w && height == h;
+	}
+
+	void RenderWorker::load(const File& file)
+	{
+		pool->addJob([s = shared, file]()
+		{
+			if (!file.existsAsFile())
+				return;
+			const auto nImg = juce::ImageFileFormat::loadFrom(file);
+			if (!nImg.isValid())
+				return;
+			const auto w = s->canvas.isValid() ? s->canvas.getWidth() : nImg.getWidth();
+			const auto h = s->canvas.isValid() ? s->canvas.getHeight() : nImg.getHeight();
+			s->canvas = juce::SoftwareImageType().convert(nImg.convertedToFormat(s->format));
+			s->resize(w, h);
+			s->publish();
+		});
+	}
+
+	void RenderWorker::save(const File& file)
+	{
+		pool->addJob([s = shared, file]()
+		{
+			if (!s->canvas.isValid())
+				return;
+			if (file.existsAsFile())
+				file.deleteFile();
+			juce::FileOutputStream stream(file);
+			juce::PNGImageFormat pngWriter;
+			pngWriter.writeImageToStream(s->canvas, stream);
+		});
+	}
+
+	bool RenderWorker::fetch(Image& front)
+	{
+		const std::lock_guard<std::mutex> lock(shared->mutex);
+		if (!shared->ready)
+			return false;
+		std::swap(front, shared->back);
+		shared->ready = false;
+		return true;
+	}
+
+	bool RenderWorker::isBusy() const noexcept
+	{
+		return shared->numRenders.load() != 0;
+	}
+
+	void RenderWorker::wait() const noexcept
+	{
+		while (isBusy())
+			juce::Thread::sleep(1);
+	}
+
+	void RenderWorker::launch(Job&& job)
+	{
+		juce::SharedResourcePointer<Pool>()->addJob(std::move(job));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+#include "Using.h"
+#include <mutex>
+
+namespace gui
+{
+	// renders procedural images off the message thread.
+	// the worker owns a canvas that keeps its content between frames. finished frames are copied
+	// into a back buffer, which the message thread swaps with the image it paints.
+	// all editors share one low priority thread, so png encoding happens there too
+	class RenderWorker
+	{
+		struct Pool :
+			public juce::ThreadPool
+		{
+			Pool();
+
+			~Pool() override;
+		};
+
+		struct Shared
+		{
+			// format
+			Shared(Image::PixelFormat);
+
+			// width, height
+			void resize(int, int);
+
+			void publish();
+
+			std::mutex mutex;
+			Image canvas, spare, back;
+			Image::PixelFormat format;
+			std::atomic<int> numRenders;
+			bool ready;
+		};
+	public:
+		// canvas
+		using RenderFunc = std::function<void(Image&)>;
+		using Job = std::function<void()>;
+
+		// format
+		RenderWorker(Image::PixelFormat);
+
+		// waits for the renders in flight, pending saves still finish
+		~RenderWorker();
+
+		// renderFunc, runs on the worker with the canvas
+		void render(RenderFunc&&);
+
+		// width, height
+		void setSize(int, int);
+
+		// width, height
+		bool hasSize(int, int) const noexcept;
+
+		// file, the decoded image becomes the canvas
+		void load(const File&);
+
+		// file, encodes the canvas as png
+		void save(const File&);
+
+		// front, swaps the latest frame in. returns true if there was one
+		bool fetch(Image&);
+
+		bool isBusy() const noexcept;
+
+		// renders can reference their component, so it waits for them before it dies
+		void wait() const noexcept;
+
+		// job, runs on the shared thread without a canvas. it should not reference components
+		// directly, but post its result back to the message thread
+		static void launch(Job&&);
+	private:
+		juce::SharedResourcePointer<Pool> pool;
+		std::shared_ptr<Shared> shared;
+		int width, height;
+	};
+}
\ No newline at end of file
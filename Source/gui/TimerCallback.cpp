@@ -2,12 +2,18 @@
 
 namespace gui
 {
-	TimerCallbacks::CB::CB(std::function<void()> _func, int _id, kFPS _fps, bool _active):
+	TimerCallbacks::CB::CB(std::function<void()> _func, int _id, kFPS _fps, bool _active, Priority _priority):
 		cb(_func),
 		phase(0.f),
 		id(_id),
 		fps(_fps),
-		active(_active)
+		active(_active),
+		priority(_priority),
+		name(nullptr),
+		cost(0.),
+		handle(-1),
+		deferrals(0),
+		due(false)
 	{
 	}
 
@@ -26,34 +32,92 @@ namespace gui
 	TimerCallbacks::TimerCallbacks() :
 		Timer(),
 		callbacks(),
-		idx(0)
+		frameCost(0.),
+		idx(0),
+		numDeferred(0),
+		iterating(false),
+		hasHoles(false)
 	{
 		startTimerHz(FPS);
 	}
 
 	void TimerCallbacks::add(CB* cb)
 	{
+		if (cb->handle != -1)
+			return;
 		auto& cbs = callbacks[static_cast<int>(cb->fps)];
+		cb->handle = static_cast<int>(cbs.size());
 		cbs.push_back(cb);
 	}
 
 	void TimerCallbacks::remove(CB* cb)
 	{
-		for (auto i = 0; i < NumFPSs; ++i)
+		if (cb->handle == -1)
+			return;
+		auto& cbs = callbacks[static_cast<int>(cb->fps)];
+		if (iterating)
 		{
-			auto& cbs = callbacks[i];
-			const auto it = std::find(cbs.begin(), cbs.end(), cb);
-			if (it != cbs.end())
-			{
-				cbs.erase(it);
-				return remove(cb);
-			}
+			// swapping now would move the last callback behind the running index
+			cbs[cb->handle] = nullptr;
+			hasHoles = true;
+		}
+		else
+		{
+			auto last = cbs.back();
+			cbs[cb->handle] = last;
+			last->handle = cb->handle;
+			cbs.pop_back();
+		}
+		cb->handle = -1;
+		cb->due = false;
+	}
+
+	void TimerCallbacks::compact()
+	{
+		for (auto& cbs : callbacks)
+		{
+			cbs.erase(std::remove(cbs.begin(), cbs.end(), nullptr), cbs.end());
+			for (auto j = 0; j < cbs.size(); ++j)
+				cbs[j]->handle = j;
+		}
+		hasHoles = false;
+	}
+
+	void TimerCallbacks::paintStats(Graphics& g, BoundsF bounds) const
+	{
+		std::vector<const CB*> cbs;
+		for (const auto& bucket : callbacks)
+			for (const auto cb : bucket)
+				if (cb != nullptr)
+					cbs.push_back(cb);
+		const auto numStats = std::min(NumStats, static_cast<int>(cbs.size()));
+		std::partial_sort(cbs.begin(), cbs.begin() + numStats, cbs.end(), [](const CB* a, const CB* b)
+		{
+			return a->cost > b->cost;
+		});
+
+		String txt;
+		txt << "frame: " << String(frameCost, 2) << "ms, deferred: " << numDeferred << "\n";
+		for (auto i = 0; i < numStats; ++i)
+		{
+			const auto& cb = *cbs[i];
+			txt << String(cb.cost, 3) << "ms " << (cb.name == nullptr ? "?" : cb.name) << " #" << cb.id;
+			if (cb.priority == Priority::Low)
+				txt << " (low)";
+			txt << "\n";
 		}
+
+		g.setColour(juce::Colours::black.withAlpha(.7f));
+		g.fillRect(bounds);
+		g.setColour(juce::Colours::white);
+		g.drawFittedText(txt, bounds.toNearestInt(), Just::topLeft, NumStats + 1);
 	}
 
 	void TimerCallbacks::timerCallback()
 	{
 		++idx;
+		const auto startMs = juce::Time::getMillisecondCounterHiRes();
+		iterating = true;
 
 		for (auto i = 0; i < NumFPSs; ++i)
 		{
@@ -62,14 +126,62 @@ namespace gui
 			const auto fpsOrder = 1 << static_cast<int>(fps); // 2^0 = 1, 2^1 = 2, 2^2 = 4, 2^3 = 8, 2^4 = 16
 
 			if (idx % fpsOrder == 0)
-				for (auto cb : cbs)
-					if(cb->active)
-						cb->cb();
+				// by index, because callbacks may add or remove callbacks
+				for (auto j = 0; j < cbs.size(); ++j)
+				{
+					if (cbs[j] == nullptr)
+						continue;
+					auto& cb = *cbs[j];
+					if (!cb.active)
+						continue;
+					if (cb.priority == Priority::Low)
+						cb.due = true;
+					else
+						run(cb);
+				}
 		}
 
+		numDeferred = 0;
+		for (auto i = 0; i < NumFPSs; ++i)
+		{
+			const auto& cbs = callbacks[i];
+			for (auto j = 0; j < cbs.size(); ++j)
+			{
+				if (cbs[j] == nullptr)
+					continue;
+				auto& cb = *cbs[j];
+				if (!cb.due)
+					continue;
+				const auto overBudget = juce::Time::getMillisecondCounterHiRes() - startMs > BudgetMs;
+				if (overBudget && cb.deferrals < MaxDeferrals)
+				{
+					++cb.deferrals;
+					++numDeferred;
+					continue;
+				}
+				cb.due = false;
+				cb.deferrals = 0;
+				if (cb.active)
+					run(cb);
+			}
+		}
+
+		iterating = false;
+		if (hasHoles)
+			compact();
+
+		frameCost = juce::Time::getMillisecondCounterHiRes() - startMs;
 		idx &= 31;
 	}
 
+	void TimerCallbacks::run(CB& cb)
+	{
+		const auto startMs = juce::Time::getMillisecondCounterHiRes();
+		cb.cb();
+		const auto cost = juce::Time::getMillisecondCounterHiRes() - startMs;
+		cb.cost += CostSmoothing * (cost - cb.cost);
+	}
+
 	float secsToInc(float secs, cbFPS fps) noexcept
 	{
 		switch (fps)
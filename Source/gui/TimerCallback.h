@@ -17,11 +17,23 @@ namespace gui
 			NumFPSs
 		};
 		static constexpr int NumFPSs = static_cast<int>(kFPS::NumFPSs);
+
+		// low priority callbacks are deferred while a frame is over budget
+		enum class Priority { High, Low };
+
+		// callbacks that ran later than this in a frame defer the low priority ones
+		static constexpr double BudgetMs = 6.;
+		// low priority callbacks run anyway after being deferred this many frames
+		static constexpr int MaxDeferrals = 8;
+		// smoothing of the measured costs
+		static constexpr double CostSmoothing = .05;
+		// number of callbacks shown by the debug overlay
+		static constexpr int NumStats = 8;
 		
 		struct CB
 		{
-			// function, id, fps, active
-			CB(std::function<void()>, int, kFPS, bool);
+			// function, id, fps, active, priority
+			CB(std::function<void()>, int, kFPS, bool, Priority = Priority::High);
 
 			void start(float) noexcept;
 
@@ -32,6 +44,15 @@ namespace gui
 			int id;
 			kFPS fps;
 			bool active;
+			Priority priority;
+			// the owner's type, for the debug overlay
+			const char* name;
+			// average ms per call
+			double cost;
+			// index into its fps bucket, -1 if not registered
+			int handle;
+			int deferrals;
+			bool due;
 		};
 
 		TimerCallbacks();
@@ -40,12 +61,24 @@ namespace gui
 
 		void remove(CB*);
 
+		// g, bounds, draws the most expensive callbacks
+		void paintStats(Graphics&, BoundsF) const;
+
 	protected:
 		using Callbacks = std::array<std::vector<CB*>, NumFPSs>;
 		Callbacks callbacks;
-		int idx;
+		double frameCost;
+		int idx, numDeferred;
+		// removals during a frame leave empty slots, which are compacted after it
+		bool iterating, hasHoles;
 
 		void timerCallback() override;
+
+		// closes the slots left by removals during the frame
+		void compact();
+
+		// cb, measures how long it takes
+		void run(CB&);
 	};
 
 	using Callback = TimerCallbacks::CB;
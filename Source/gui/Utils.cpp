@@ -8,9 +8,17 @@ namespace gui
 		pluginTop(_pluginTop),
 		audioProcessor(_audioProcessor),
 		params(audioProcessor.params),
-		thicc(2.f)
+		thicc(2.f),
+		telemetry(),
+		telemetryCallback([&]()
+		{
+			audioProcessor.telemetry.pull(telemetry);
+			eventSystem.notify(evt::Type::TelemetryUpdated, &telemetry);
+		}, 0, TimerCallbacks::kFPS::k60, true)
 	{
 		Colours::c.init(audioProcessor.state.props.getUserSettings());
+		telemetryCallback.name = "Telemetry";
+		callbacks.add(&telemetryCallback);
 	}
 
 	void Utils::add(Callback* ncb)
@@ -85,8 +93,12 @@ namespace gui
 
 	void Utils::loadPatch(const ValueTree& vt)
 	{
-		audioProcessor.state.loadPatch(vt);
-		audioProcessor.pluginProcessor.loadPatch(audioProcessor.state);
+		auto& processor = audioProcessor;
+		processor.loadPatchStaged([&processor, vt]()
+		{
+			processor.state.loadPatch(vt);
+			processor.pluginProcessor.loadPatch(processor.state);
+		});
 	}
 
 	Props& Utils::getProps() noexcept
@@ -43,5 +43,8 @@ namespace gui
 		Processor& audioProcessor;
 		Params& params;
 		float thicc;
+		// the newest record of the audio thread, notified with TelemetryUpdated every frame
+		dsp::Telemetry::Record telemetry;
+		Callback telemetryCallback;
 	};
 }
\ No newline at end of file
@@ -6,19 +6,40 @@ namespace gui
 	VoiceGrid<NumVoices>::VoiceGrid(Utils& u) :
 		Comp(u),
 		voices(),
+		levels(),
 		poly(NumVoices)
 	{
+		addEvt([this](const evt::Type type, const void* stuff)
+		{
+			if (type != evt::Type::TelemetryUpdated)
+				return;
+			if (update(*static_cast<const dsp::Telemetry::Record*>(stuff)))
+				repaint();
+		});
 	}
-	
+
 	template<size_t NumVoices>
-	void VoiceGrid<NumVoices>::init(const UpdateFunc& updateFunc)
+	bool VoiceGrid<NumVoices>::update(const dsp::Telemetry::Record& record) noexcept
 	{
-		const auto fps = cbFPS::k30;
-		add(Callback([&, wannaRepaint = updateFunc]()
+		bool updated = false;
+		const auto nPoly = std::min(record.polyphony, static_cast<int>(NumVoices));
+		if (poly != nPoly)
 		{
-			if (wannaRepaint(voices))
-				repaint();
-		}, 0, fps, true));
+			updated = true;
+			poly = nPoly;
+		}
+		for (auto i = 0; i < poly; ++i)
+		{
+			const auto active = (record.voicesActive & (1 << i)) != 0;
+			const auto level = std::round(std::min(record.voiceLevels[i], 1.f) * LevelSteps) / LevelSteps;
+			if (voices[i] != active || levels[i] != level)
+			{
+				updated = true;
+				voices[i] = active;
+				levels[i] = level;
+			}
+		}
+		return updated;
 	}
 
 	template<size_t NumVoices>
@@ -41,7 +62,7 @@ namespace gui
 			BoundsF bounds(x, y, w2, h);
 			if (voice)
 			{
-				g.setColour(col);
+				g.setColour(col.withMultipliedAlpha(.4f + .6f * levels[0]));
 				g.fillRoundedRectangle(bounds.reduced(thicc2), thicc);
 				g.setColour(colDarker);
 			}
@@ -54,7 +75,7 @@ namespace gui
 			g.drawLine(x, y, x, h, thicc);
 			if (voice)
 			{
-				g.setColour(col);
+				g.setColour(col.withMultipliedAlpha(.4f + .6f * levels[i]));
 				g.fillRoundedRectangle(bounds.reduced(thicc2), thicc);
 				g.setColour(colDarker);
 			}
@@ -9,18 +9,22 @@ namespace gui
 	{
 		static constexpr float NumVoicesF = static_cast<float>(NumVoices);
 		static constexpr float NumVoicesInv = 1.f / NumVoicesF;
+		// levels are shown in this many steps, so that a ringing voice doesn't repaint every frame
+		static constexpr float LevelSteps = 8.f;
 		using Voices = std::array<bool, NumVoices>;
-		using UpdateFunc = std::function<bool(Voices&)>;
+		using Levels = std::array<float, NumVoices>;
 
+		// subscribes to the telemetry of the audio thread
 		VoiceGrid(Utils&);
 
-		void init(const UpdateFunc&);
-
 		void paint(Graphics&) override;
 
 	protected:
-		std::array<bool, NumVoices> voices;
-	public:
+		Voices voices;
+		Levels levels;
 		int poly;
+
+		// record, returns true if anything visible changed
+		bool update(const dsp::Telemetry::Record&) noexcept;
 	};
 }
\ No newline at end of file
@@ -173,7 +173,10 @@ namespace gui
 		draggerfall(),
 		dragXY(),
 		freqRatioRange(1.f),
-		xenInfo(u.audioProcessor.xenManager.getInfo())
+		xenInfo(u.audioProcessor.xenManager.getInfo()),
+		spectrum(),
+		energies(),
+		ratioToX(1.f)
 	{
 		layout.init
 		(
@@ -217,6 +220,18 @@ namespace gui
 			repaint();
 		}, kXenUpdatedCB, cbFPS::k7_5, true));
 
+		add(Callback([&]()
+		{
+			if (!isShowing())
+				return;
+			auto changed = spectrum.fetch();
+			changed = updateEnergies() || changed;
+			spectrum.update(utils.audioProcessor.telemetry, utils.telemetry,
+				ratioToX, Colours::c(CID::Hover), utils.thicc);
+			if (changed)
+				repaint();
+		}, kSpectrumCB, ModalSpectrum::UpdateFPS, true, Callback::Priority::Low));
+
 		addChildComponent(dragAniComp);
 	}
 
@@ -264,6 +279,7 @@ namespace gui
 		g.fillRect(0.f, 0.f, w, rulerTop);
 		const auto rulerBtm = h;
 		ruler.paintStripes(g, rulerTop, rulerBtm, 33);
+		spectrum.paint(g);
 
 		if (isMouseOver() && !isMouseButtonDownAnywhere())
 			draggerfall.paint(g, thicc2);
@@ -290,6 +306,11 @@ namespace gui
 		const auto x = partials[i].x;
 		const auto y = partials[i].y;
 
+		// how loud the partial's resonator actually rings
+		const auto energyH = energies[i] * h;
+		g.setColour(Colours::c(CID::Interact).withMultipliedAlpha(.35f));
+		g.fillRect(x - knotW, h - energyH, knotW2, energyH);
+
 		if (selected)
 			g.setColour(Colours::c(CID::Interact));
 		else
@@ -312,9 +333,28 @@ namespace gui
 		layout.resized(getLocalBounds().toFloat());
 		layout.place(ruler, 0, 0, 1, 1);
 		dragAniComp.setBounds(getLocalBounds());
+		spectrum.setSize(getWidth(), getHeight());
 		updatePartials();
 	}
 
+	bool ModalMaterialEditor::updateEnergies() noexcept
+	{
+		// quantized, so that resonators ringing out don't repaint every frame
+		static constexpr float Steps = 64.f;
+		bool changed = false;
+		for (auto i = 0; i < NumPartials; ++i)
+		{
+			const auto level = ModalSpectrum::toLevel(utils.telemetry.partialEnergies[i]);
+			const auto quantized = std::round(level * Steps) / Steps;
+			if (energies[i] != quantized)
+			{
+				energies[i] = quantized;
+				changed = true;
+			}
+		}
+		return changed;
+	}
+
 	void ModalMaterialEditor::updatePartials()
 	{
 		updatePartialsRatios();
@@ -349,6 +389,7 @@ namespace gui
 		}
 		maxRatio -= 1.f;
 		const auto maxRatioInv = 1.f / maxRatio;
+		ratioToX = maxRatioInv * w;
 
 		for (auto i = 0; i < NumPartials; ++i)
 		{
@@ -2,6 +2,7 @@
 #include "../Button.h"
 #include "../../audio/dsp/hnm/modal/Material.h"
 #include "../Ruler.h"
+#include "ModalSpectrum.h"
 
 namespace gui
 {
@@ -79,6 +80,7 @@ namespace gui
 			kStrumCB = 1,
 			kNumStrumsCB = kStrumCB + NumPartials,
 			kXenUpdatedCB,
+			kSpectrumCB,
 			kNumCallbacks
 		};
 
@@ -108,6 +110,14 @@ namespace gui
 		float freqRatioRange;
 	private:
 		arch::XenManager::Info xenInfo;
+		ModalSpectrum spectrum;
+		// level of each partial's resonator, [0, 1]
+		std::array<float, NumPartials> energies;
+		// x = (ratio - 1) * ratioToX
+		float ratioToX;
+
+		// returns true if the energies changed
+		bool updateEnergies() noexcept;
 
 		void updatePartials();
 
@@ -455,6 +455,7 @@ namespace gui
 		buttonRandomizer.add(PID::CombFeedbackEnv);
 		buttonRandomizer.add(PID::CombFeedbackWidth);
 		buttonRandomizer.add(PID::CombUnison);
+		buttonRandomizer.add(PID::CombChordDepth);
 		buttonRandomizer.add(PID::ModalBlend);
 		buttonRandomizer.add(PID::ModalBlendEnv);
 		buttonRandomizer.add(PID::ModalBlendBreite);
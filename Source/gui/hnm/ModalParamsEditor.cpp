@@ -31,6 +31,34 @@ namespace gui
 		locateAtSlider(modDial, knob);
 	}
 
+	ModalParamsEditor::DepthKnob::DepthKnob(Utils& u, PID pID, String&& name) :
+		Comp(u),
+		label(u),
+		knob(u),
+		modDial(u)
+	{
+		layout.init
+		(
+			{ 3, 2 },
+			{ 1 }
+		);
+
+		addAndMakeVisible(label);
+		addAndMakeVisible(knob);
+		addAndMakeVisible(modDial);
+		makeKnob(pID, knob);
+		modDial.attach(pID);
+		makeTextLabel(label, name, font::dosisBold(), Just::topLeft, CID::Txt);
+	}
+
+	void ModalParamsEditor::DepthKnob::resized()
+	{
+		layout.resized(getLocalBounds());
+		layout.place(label, .1f, 0.f, .9f, .5f);
+		layout.place(knob, 1, 0, 1, 1, true);
+		locateAtKnob(modDial, knob);
+	}
+
 	//
 
 	ModalParamsEditor::ModalParamsEditor(Utils& u) :
@@ -40,6 +68,8 @@ namespace gui
 		octComb(u, PID::CombOct, "C Oct"),
 		semiComb(u, PID::CombSemi, "C Semi"),
 		unisonComb(u, PID::CombUnison, "C Unison"),
+		chordComb(u, PID::CombChord, "C Chord"),
+		chordDepthComb(u, PID::CombChordDepth, "C Depth"),
 		blend(u, PID::ModalBlend, PID::ModalBlendEnv, PID::ModalBlendBreite, "Blend"),
 		spreizung(u, PID::ModalSpreizung, PID::ModalSpreizungEnv, PID::ModalSpreizungBreite, "Spreizung"),
 		harmonie(u, PID::ModalHarmonie, PID::ModalHarmonieEnv, PID::ModalHarmonieBreite, "Harmonie"),
@@ -61,11 +91,15 @@ namespace gui
 		addAndMakeVisible(octComb);
 		addAndMakeVisible(semiComb);
 		addAndMakeVisible(unisonComb);
+		addAndMakeVisible(chordComb);
+		addAndMakeVisible(chordDepthComb);
 		octSemiGroup.add(octModal.label);
 		octSemiGroup.add(semiModal.label);
 		octSemiGroup.add(octComb.label);
 		octSemiGroup.add(semiComb.label);
 		octSemiGroup.add(unisonComb.label);
+		octSemiGroup.add(chordComb.label);
+		octSemiGroup.add(chordDepthComb.label);
 
 		addAndMakeVisible(blend);
 		addAndMakeVisible(spreizung);
@@ -90,7 +124,7 @@ namespace gui
 		{
 			const auto sliderArea = layout(0, 0.f, 8, 1.1f);
 			const auto y = sliderArea.getY();
-			const auto w = sliderArea.getWidth() / 5.f;
+			const auto w = sliderArea.getWidth() / 7.f;
 			const auto h = sliderArea.getHeight();
 			auto x = 0.f;
 			octModal.setBounds(BoundsF(x, y, w, h).toNearestInt());
@@ -102,6 +136,10 @@ namespace gui
 			semiComb.setBounds(BoundsF(x, y, w, h).toNearestInt());
 			x += w;
 			unisonComb.setBounds(BoundsF(x, y, w, h).toNearestInt());
+			x += w;
+			chordComb.setBounds(BoundsF(x, y, w, h).toNearestInt());
+			x += w;
+			chordDepthComb.setBounds(BoundsF(x, y, w, h).toNearestInt());
 		}
 		octSemiGroup.setMaxHeight();
 
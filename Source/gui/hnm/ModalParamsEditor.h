@@ -22,12 +22,27 @@ namespace gui
 			ModDial modDial;
 		};
 
+		// a continuous knob for the slider row, next to its label
+		struct DepthKnob :
+			public Comp
+		{
+			//utils, pID, name
+			DepthKnob(Utils&, PID, String&&);
+
+			void resized() override;
+
+			Label label;
+			Knob knob;
+			ModDial modDial;
+		};
+
 		ModalParamsEditor(Utils&);
 
 		void resized() override;
 
 	protected:
-		OctSemiSlider octModal, semiModal, octComb, semiComb, unisonComb;
+		OctSemiSlider octModal, semiModal, octComb, semiComb, unisonComb, chordComb;
+		DepthKnob chordDepthComb;
 		KnobHnM blend, spreizung, harmonie, kraft, reso, damp, feedback;
 		LabelGroup octSemiGroup, knobLabelsGroup;
 	};
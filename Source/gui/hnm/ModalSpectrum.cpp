@@ -0,0 +1,117 @@
+#include "ModalSpectrum.h"
+
+namespace gui
+{
+	// Analysis
+
+	ModalSpectrum::Analysis::Analysis() :
+		fft(Order),
+		window(Size, juce::dsp::WindowingFunction<float>::hann, true),
+		bins(),
+		magsDb()
+	{
+		magsDb.fill(FloorDb);
+	}
+
+	void ModalSpectrum::Analysis::render(Image& canvas, const Samples& samples, float scopeRate,
+		float fundamentalHz, float ratioToX, Colour col, float thicc)
+	{
+		// a normalized window makes a full scale sine peak at Size / 2
+		static constexpr auto Gain = 2.f / static_cast<float>(Size);
+
+		std::copy(samples.begin(), samples.end(), bins.begin());
+		std::fill(bins.begin() + Size, bins.end(), 0.f);
+		window.multiplyWithWindowingTable(bins.data(), Size);
+		fft.performFrequencyOnlyForwardTransform(bins.data(), true);
+		for (auto k = 0; k < NumBins; ++k)
+		{
+			const auto db = juce::Decibels::gainToDecibels(bins[k] * Gain, FloorDb);
+			magsDb[k] = std::max(db, magsDb[k] - ReleaseDb);
+		}
+
+		canvas.clear(canvas.getBounds());
+		const auto w = static_cast<float>(canvas.getWidth());
+		const auto h = static_cast<float>(canvas.getHeight());
+		const auto binToRatio = scopeRate / (static_cast<float>(Size) * fundamentalHz);
+		const auto floorDbInv = 1.f / FloorDb;
+
+		juce::Path path;
+		path.startNewSubPath(0.f, h);
+		for (auto k = 1; k < NumBins; ++k)
+		{
+			const auto x = (static_cast<float>(k) * binToRatio - 1.f) * ratioToX;
+			if (x < 0.f)
+				continue;
+			const auto y = magsDb[k] * floorDbInv * h;
+			path.lineTo(x, y);
+			if (x > w)
+				break;
+		}
+		path.lineTo(path.getCurrentPosition().x, h);
+		path.closeSubPath();
+
+		Graphics g(canvas);
+		g.setColour(col.withMultipliedAlpha(.2f));
+		g.fillPath(path);
+		g.setColour(col.withMultipliedAlpha(.6f));
+		g.strokePath(path, juce::PathStrokeType(thicc * .5f));
+	}
+
+	// ModalSpectrum
+
+	ModalSpectrum::ModalSpectrum() :
+		worker(Image::PixelFormat::ARGB),
+		analysis(std::make_shared<Analysis>()),
+		samples(),
+		img(),
+		fundamentalHz(0.f)
+	{}
+
+	void ModalSpectrum::setSize(int w, int h)
+	{
+		worker.setSize(w, h);
+	}
+
+	void ModalSpectrum::update(dsp::Telemetry& telemetry, const Record& record,
+		float ratioToX, Colour col, float thicc)
+	{
+		// the newest samples always end up at the end of the window
+		Samples nSamples;
+		auto numSamples = telemetry.pullScope(nSamples.data(), Size);
+		if (numSamples == 0)
+		{
+			// the audio thread sleeps, so the window fills with the silence it skipped
+			numSamples = std::min(Size, static_cast<int>(record.scopeRate * secsToInc(1.f, UpdateFPS)));
+			std::fill(nSamples.begin(), nSamples.begin() + numSamples, 0.f);
+		}
+		std::copy(samples.begin() + numSamples, samples.end(), samples.begin());
+		std::copy(nSamples.begin(), nSamples.begin() + numSamples, samples.end() - numSamples);
+
+		if (record.fundamentalHz > 0.f)
+			fundamentalHz = record.fundamentalHz;
+		if (fundamentalHz == 0.f || worker.isBusy())
+			return;
+		worker.render([a = analysis, s = samples, r = record.scopeRate,
+			f = fundamentalHz, ratioToX, col, thicc](Image& canvas)
+		{
+			a->render(canvas, s, r, f, ratioToX, col, thicc);
+		});
+	}
+
+	bool ModalSpectrum::fetch()
+	{
+		return worker.fetch(img);
+	}
+
+	void ModalSpectrum::paint(Graphics& g) const
+	{
+		if (img.isValid())
+			g.drawImageAt(img, 0, 0, false);
+	}
+
+	float ModalSpectrum::toLevel(float energy) noexcept
+	{
+		const auto db = juce::Decibels::gainToDecibels(std::sqrt(energy), FloorDb);
+		return 1.f - db / FloorDb;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+#include "../RenderWorker.h"
+#include "../TimerCallback.h"
+#include <juce_dsp/juce_dsp.h>
+
+namespace gui
+{
+	// live spectrum of the output for the material editors.
+	// the message thread only collects the scope's samples, the windowed fft and
+	// the drawing of the curve happen on the render worker
+	class ModalSpectrum
+	{
+		static constexpr int Order = 11;
+		static constexpr int Size = 1 << Order;
+		static constexpr int NumBins = Size / 2;
+		static constexpr float FloorDb = -84.f;
+		// how fast the curve falls per frame
+		static constexpr float ReleaseDb = 1.5f;
+		using Samples = std::array<float, Size>;
+
+		struct Analysis
+		{
+			Analysis();
+
+			// canvas, samples, scopeRate, fundamentalHz, ratioToX, colour, thicc
+			void render(Image&, const Samples&, float, float, float, Colour, float);
+
+			juce::dsp::FFT fft;
+			juce::dsp::WindowingFunction<float> window;
+			std::array<float, Size * 2> bins;
+			std::array<float, NumBins> magsDb;
+		};
+	public:
+		using Record = dsp::Telemetry::Record;
+		// rate of update()
+		static constexpr cbFPS UpdateFPS = cbFPS::k30;
+
+		ModalSpectrum();
+
+		// width, height
+		void setSize(int, int);
+
+		// pulls the scope and renders the next frame, unless the worker is still busy with the last one
+		// telemetry, record, ratioToX, colour, thicc
+		void update(dsp::Telemetry&, const Record&, float, Colour, float);
+
+		// returns true if a new frame arrived
+		bool fetch();
+
+		void paint(Graphics&) const;
+
+		// energy, mean square of a partial, returns its level in [0, 1]
+		static float toLevel(float) noexcept;
+	private:
+		RenderWorker worker;
+		std::shared_ptr<Analysis> analysis;
+		Samples samples;
+		Image img;
+		float fundamentalHz;
+	};
+}
\ No newline at end of file
@@ -26,6 +26,9 @@ namespace gui
 		for (auto i = 0; i < param::NumParams; ++i)
 		{
 			const auto pID = static_cast<PID>(i);
+			// routes are set up on purpose, random ones would bury the patch in modulation
+			if (pID >= PID::ModSlot1Src && pID <= PID::ModSlot8Depth)
+				continue;
 			if (pID != PID::KeySelectorEnabled && pID != PID::NoiseBlend)
 				if (pID != PID::EnvGenAmpAttack && pID != PID::EnvGenAmpDecay && pID != PID::EnvGenAmpSustain && pID != PID::EnvGenAmpRelease
 					&& pID != PID::EnvGenModAttack && pID != PID::EnvGenModDecay && pID != PID::EnvGenModSustain && pID != PID::EnvGenModRelease)
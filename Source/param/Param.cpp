@@ -1,4 +1,5 @@
 #include "Param.h"
+#include "../audio/dsp/ModMatrix.h"
 #include "../arch/FormulaParser.h"
 #include "../arch/Range.h"
 
@@ -110,6 +111,7 @@ namespace param
 		case PID::ModalResonanzBreite: return "Modal Reso Breite";
 		//
 		case PID::Polyphony: return "Polyphony";
+		case PID::PolyGovernor: return "Poly Governor";
 		//
 		case PID::FormantA: return "Formant A";
 		case PID::FormantB: return "Formant B";
@@ -128,11 +130,38 @@ namespace param
 		case PID::CombFeedback: return "Comb Feedback";
 		case PID::CombFeedbackEnv: return "Comb Feedback Env";
 		case PID::CombFeedbackWidth: return "Comb Feedback Width";
+		case PID::CombChord: return "Comb Chord";
+		case PID::CombChordDepth: return "Comb Chord Depth";
 		//
 		case PID::Damp: return "Damp";
 		case PID::DampEnv: return "Damp Env";
 		case PID::DampWidth: return "Damp Width";
 		//
+		case PID::ModSlot1Src: return "Mod Slot 1 Src";
+		case PID::ModSlot1Dest: return "Mod Slot 1 Dest";
+		case PID::ModSlot1Depth: return "Mod Slot 1 Depth";
+		case PID::ModSlot2Src: return "Mod Slot 2 Src";
+		case PID::ModSlot2Dest: return "Mod Slot 2 Dest";
+		case PID::ModSlot2Depth: return "Mod Slot 2 Depth";
+		case PID::ModSlot3Src: return "Mod Slot 3 Src";
+		case PID::ModSlot3Dest: return "Mod Slot 3 Dest";
+		case PID::ModSlot3Depth: return "Mod Slot 3 Depth";
+		case PID::ModSlot4Src: return "Mod Slot 4 Src";
+		case PID::ModSlot4Dest: return "Mod Slot 4 Dest";
+		case PID::ModSlot4Depth: return "Mod Slot 4 Depth";
+		case PID::ModSlot5Src: return "Mod Slot 5 Src";
+		case PID::ModSlot5Dest: return "Mod Slot 5 Dest";
+		case PID::ModSlot5Depth: return "Mod Slot 5 Depth";
+		case PID::ModSlot6Src: return "Mod Slot 6 Src";
+		case PID::ModSlot6Dest: return "Mod Slot 6 Dest";
+		case PID::ModSlot6Depth: return "Mod Slot 6 Depth";
+		case PID::ModSlot7Src: return "Mod Slot 7 Src";
+		case PID::ModSlot7Dest: return "Mod Slot 7 Dest";
+		case PID::ModSlot7Depth: return "Mod Slot 7 Depth";
+		case PID::ModSlot8Src: return "Mod Slot 8 Src";
+		case PID::ModSlot8Dest: return "Mod Slot 8 Dest";
+		case PID::ModSlot8Depth: return "Mod Slot 8 Depth";
+		//
 		default: return "Invalid Parameter Name";
 		}
 	}
@@ -250,6 +279,7 @@ namespace param
 		case PID::ModalResonanzBreite: return "The stereo width of the modal resonanz.";
 		//
 		case PID::Polyphony: return "The polyphony (number of voices) of the synth engine.";
+		case PID::PolyGovernor: return "If enabled the quietest voices fade out when the cpu can't keep up.";
 		//
 		case PID::FormantA: return "Vowel A of the formant filter.";
 		case PID::FormantB: return "Vowel B of the formant filter.";
@@ -268,11 +298,38 @@ namespace param
 		case PID::CombFeedback: return "The feedback of the comb filter's feedback delay.";
 		case PID::CombFeedbackEnv: return "The envelope generator's depth on the comb filter's feedback.";
 		case PID::CombFeedbackWidth: return "The stereo width of the comb filter's feedback.";
+		case PID::CombChord: return "Adds delay taps at chord intervals to the comb filter.";
+		case PID::CombChordDepth: return "The loudness of the comb filter's chord taps.";
 		//
 		case PID::Damp: return "Dampens the voice with a lowpass filter.";
 		case PID::DampEnv: return "The envelope generator's depth on the dampening.";
 		case PID::DampWidth: return "The stereo width of the dampening.";
 		//
+		case PID::ModSlot1Src: return "The modulation source of mod matrix slot 1.";
+		case PID::ModSlot1Dest: return "The parameter mod matrix slot 1 modulates per voice.";
+		case PID::ModSlot1Depth: return "The modulation depth of mod matrix slot 1.";
+		case PID::ModSlot2Src: return "The modulation source of mod matrix slot 2.";
+		case PID::ModSlot2Dest: return "The parameter mod matrix slot 2 modulates per voice.";
+		case PID::ModSlot2Depth: return "The modulation depth of mod matrix slot 2.";
+		case PID::ModSlot3Src: return "The modulation source of mod matrix slot 3.";
+		case PID::ModSlot3Dest: return "The parameter mod matrix slot 3 modulates per voice.";
+		case PID::ModSlot3Depth: return "The modulation depth of mod matrix slot 3.";
+		case PID::ModSlot4Src: return "The modulation source of mod matrix slot 4.";
+		case PID::ModSlot4Dest: return "The parameter mod matrix slot 4 modulates per voice.";
+		case PID::ModSlot4Depth: return "The modulation depth of mod matrix slot 4.";
+		case PID::ModSlot5Src: return "The modulation source of mod matrix slot 5.";
+		case PID::ModSlot5Dest: return "The parameter mod matrix slot 5 modulates per voice.";
+		case PID::ModSlot5Depth: return "The modulation depth of mod matrix slot 5.";
+		case PID::ModSlot6Src: return "The modulation source of mod matrix slot 6.";
+		case PID::ModSlot6Dest: return "The parameter mod matrix slot 6 modulates per voice.";
+		case PID::ModSlot6Depth: return "The modulation depth of mod matrix slot 6.";
+		case PID::ModSlot7Src: return "The modulation source of mod matrix slot 7.";
+		case PID::ModSlot7Dest: return "The parameter mod matrix slot 7 modulates per voice.";
+		case PID::ModSlot7Depth: return "The modulation depth of mod matrix slot 7.";
+		case PID::ModSlot8Src: return "The modulation source of mod matrix slot 8.";
+		case PID::ModSlot8Dest: return "The parameter mod matrix slot 8 modulates per voice.";
+		case PID::ModSlot8Depth: return "The modulation depth of mod matrix slot 8.";
+		//
 		default: return "Invalid Tooltip.";
 		}
 	}
@@ -327,27 +384,45 @@ namespace param
 		mod(),
 		valNorm(valInternal), valMod(valNorm.load()),
 		valToStr(_valToStr), strToVal(_strToVal), unit(_unit),
-		locked(false), inGesture(false), modDepthAbsolute(false)
+		locked(false), inGesture(false), modDirty(true), modDepthAbsolute(false),
+		pathValue("params/" + toID(toString(pID)) + "/value"),
+		pathModDepth("params/" + toID(toString(pID)) + "/md"),
+		pathModBias("params/" + toID(toString(pID)) + "/mb")
 	{
 	}
 
 	void Param::savePatch(State& state) const
 	{
-		const String idStr("params/" + toID(toString(id)));
 		const auto v = range.convertFrom0to1(getValue());
-		state.set(idStr + "/value", v);
+		state.set(pathValue, v);
 		const auto md = getModDepth();
-		state.set(idStr + "/md", md);
+		state.set(pathModDepth, md);
 		const auto mb = getModBias();
-		state.set(idStr + "/mb", mb);
+		state.set(pathModBias, mb);
+	}
+
+	void Param::savePatch(float* dest) const
+	{
+		dest[0] = range.convertFrom0to1(getValue());
+		dest[1] = getModDepth();
+		dest[2] = getModBias();
+	}
+
+	void Param::loadPatch(const float* src)
+	{
+		if (isLocked())
+			return;
+		const auto legalVal = range.snapToLegalValue(src[0]);
+		setValueNotifyingHost(range.convertTo0to1(legalVal));
+		setModDepth(src[1]);
+		setModBias(src[2]);
 	}
 
 	void Param::loadPatch(const State& state)
 	{
 		if (isLocked())
 			return;
-		const String idStr("params/" + toID(toString(id)));
-		auto var = state.get(idStr + "/value");
+		auto var = state.get(pathValue);
 		if (var)
 		{
 			const auto val = static_cast<float>(*var);
@@ -355,13 +430,13 @@ namespace param
 			const auto valD = range.convertTo0to1(legalVal);
 			setValueNotifyingHost(valD);
 		}
-		var = state.get(idStr + "/md");
+		var = state.get(pathModDepth);
 		if (var)
 		{
 			const auto val = static_cast<float>(*var);
 			setModDepth(val);
 		}
-		var = state.get(idStr + "/mb");
+		var = state.get(pathModBias);
 		if (var)
 		{
 			const auto val = static_cast<float>(*var);
@@ -386,7 +461,11 @@ namespace param
 			return;
 
 		if (!modDepthAbsolute)
-			return valNorm.store(normalized);
+		{
+			valNorm.store(normalized);
+			modDirty.store(true);
+			return;
+		}
 
 		const auto pLast = valNorm.load();
 		const auto pCur = normalized;
@@ -396,6 +475,7 @@ namespace param
 		setModDepth(dCur);
 
 		valNorm.store(pCur);
+		modDirty.store(true);
 	}
 
 	void Param::setValueFromEditor(float x) noexcept
@@ -445,6 +525,7 @@ namespace param
 			return;
 
 		mod.depth.store(juce::jlimit(-1.f, 1.f, v));
+		modDirty.store(true);
 	}
 
 	float Param::calcValModOf(float modSrc) const noexcept
@@ -475,6 +556,7 @@ namespace param
 		b = BiasEps + b * (1.f - 2.f * BiasEps);
 		b = juce::jlimit(BiasEps, 1.f - BiasEps, b);
 		mod.bias.store(b);
+		modDirty.store(true);
 	}
 
 	float Param::getModBias() const noexcept
@@ -513,6 +595,14 @@ namespace param
 		valMod.store(juce::jlimit(0.f, 1.f, valInternal));
 	}
 
+	bool Param::consumeModDirty() noexcept
+	{
+		// plain load first, so that clean parameters cost no read-modify-write
+		if (!modDirty.load())
+			return false;
+		return modDirty.exchange(false);
+	}
+
 	float Param::getDefaultValue() const
 	{
 		return range.convertTo0to1(valDenormDefault);
@@ -1019,6 +1109,52 @@ namespace param::strToVal
 			return val;
 		};
 	}
+
+	StrToValFunc chord()
+	{
+		return[p = parse()](const String& txt)
+		{
+			const auto nTxt = txt.toLowerCase().removeCharacters(" ");
+
+			for (auto i = 0; i < dsp::hnm::NumChordTypes; ++i)
+			{
+				const auto chordType = static_cast<dsp::hnm::ChordType>(i);
+				const auto chordStr = dsp::hnm::toString(chordType).toLowerCase().removeCharacters(" ");
+				if (nTxt == chordStr)
+					return static_cast<float>(i);
+			}
+			return p(txt, 0.f);
+		};
+	}
+
+	StrToValFunc modSrc()
+	{
+		return[p = parse()](const String& txt)
+		{
+			const auto nTxt = toID(txt);
+
+			for (auto i = 0; i < dsp::ModMatrix::kNumSources; ++i)
+			{
+				const auto src = static_cast<dsp::ModMatrix::Source>(i);
+				if (nTxt == toID(dsp::toString(src)))
+					return static_cast<float>(i);
+			}
+			return p(txt, 0.f);
+		};
+	}
+
+	StrToValFunc modDest()
+	{
+		return[p = parse()](const String& txt)
+		{
+			const auto nTxt = toID(txt);
+
+			for (auto i = 0; i < NumModDests; ++i)
+				if (nTxt == toID(toString(ModDests[i])))
+					return static_cast<float>(i);
+			return p(txt, 0.f);
+		};
+	}
 }
 
 namespace param::valToStr
@@ -1313,6 +1449,35 @@ namespace param::valToStr
 				return dsp::formant::toString(vowelClass);
 			};
 	}
+
+	ValToStrFunc chord()
+	{
+		return [](float v)
+			{
+				v = std::round(v);
+				const auto cInt = static_cast<int>(v);
+				const auto chordType = static_cast<dsp::hnm::ChordType>(cInt);
+				return dsp::hnm::toString(chordType);
+			};
+	}
+
+	ValToStrFunc modSrc()
+	{
+		return [](float v)
+			{
+				const auto sInt = static_cast<int>(std::round(v));
+				return dsp::toString(static_cast<dsp::ModMatrix::Source>(sInt));
+			};
+	}
+
+	ValToStrFunc modDest()
+	{
+		return [](float v)
+			{
+				const auto dInt = juce::jlimit(0, NumModDests - 1, static_cast<int>(std::round(v)));
+				return toString(ModDests[dInt]);
+			};
+	}
 }
 
 namespace param
@@ -1414,6 +1579,10 @@ namespace param
 			valToStrFunc = valToStr::vowel();
 			strToValFunc = strToVal::vowel();
 			break;
+		case Unit::Chord:
+			valToStrFunc = valToStr::chord();
+			strToValFunc = strToVal::chord();
+			break;
 		default:
 			valToStrFunc = [](float v) { return String(v); };
 			strToValFunc = [p = strToVal::parse()](const String& s)
@@ -1461,6 +1630,54 @@ namespace param
 		return new Param(id, range, valDenormDefault, valToStrFunc, strToValFunc, Unit::Custom);
 	}
 
+	// PARAM SNAPSHOT
+
+	ParamSnapshot::ParamSnapshot() :
+		valsNorm(),
+		valsDenorm(),
+		versions()
+	{
+		valsNorm.fill(-1.f);
+	}
+
+	void ParamSnapshot::update(const Parameters& params) noexcept
+	{
+		for (auto i = 0; i < NumParams; ++i)
+		{
+			const auto& param = *params[i];
+			// the macro is the modulation source, so it has no modulated value
+			const auto valNorm = i == 0 ? param.getValue() : param.getValMod();
+			if (valsNorm[i] == valNorm)
+				continue;
+			valsNorm[i] = valNorm;
+			valsDenorm[i] = param.range.convertFrom0to1(valNorm);
+			++versions[i];
+		}
+	}
+
+	float ParamSnapshot::operator()(PID pID) const noexcept
+	{
+		return valsDenorm[static_cast<int>(pID)];
+	}
+
+	float ParamSnapshot::getNorm(PID pID) const noexcept
+	{
+		return valsNorm[static_cast<int>(pID)];
+	}
+
+	ParamSnapshot::Version ParamSnapshot::getVersion(PID pID) const noexcept
+	{
+		return versions[static_cast<int>(pID)];
+	}
+
+	ParamSnapshot::Version ParamSnapshot::getVersion(std::initializer_list<PID> pIDs) const noexcept
+	{
+		Version v = 0;
+		for (const auto pID : pIDs)
+			v += versions[static_cast<int>(pID)];
+		return v;
+	}
+
 	// PARAMS
 
 	Params::Params(AudioProcessor& audioProcessor
@@ -1469,7 +1686,11 @@ namespace param
 #endif
 	) :
 		params(),
-		modDepthAbsolute(false)
+		snapshot(),
+		modDepthAbsolute(false),
+		modSrcLast(-1.f),
+		modEpoch(0),
+		pathModDepthAbsolute("params/mdabs")
 	{
 		{ // HIGH LEVEL PARAMS:
 			params.push_back(makeParam(PID::Macro, 1.f));
@@ -1606,6 +1827,20 @@ namespace param
 		params.push_back(makeParam(PID::Damp, numOctavesDamp, makeRange::lin(0.f, numOctavesDamp), Unit::OctavesFloat));
 		params.push_back(makeParam(PID::DampEnv, 0.f, makeRange::lin(-numOctavesDamp, numOctavesDamp), Unit::OctavesFloat));
 		params.push_back(makeParam(PID::DampWidth, 0.f, makeRange::lin(-2., 2.), Unit::OctavesFloat));
+		// appended after the 1.0 layout, see PID
+		const auto maxChordF = static_cast<float>(dsp::hnm::NumChordTypes - 1);
+		params.push_back(makeParam(PID::CombChord, 0.f, makeRange::stepped(0.f, maxChordF), Unit::Chord));
+		params.push_back(makeParam(PID::CombChordDepth, .5f, makeRange::lin(0.f, 1.f)));
+		params.push_back(makeParam(PID::PolyGovernor, 0.f, makeRange::toggle(), Unit::Power));
+		const auto maxModSrcF = static_cast<float>(dsp::ModMatrix::kNumSources - 1);
+		const auto maxModDestF = static_cast<float>(NumModDests - 1);
+		for (auto i = 0; i < NumModSlots; ++i)
+		{
+			const auto pIDSrc = offset(PID::ModSlot1Src, i * NumParamsPerModSlot);
+			params.push_back(makeParam(pIDSrc, 0.f, makeRange::stepped(0.f, maxModSrcF), valToStr::modSrc(), strToVal::modSrc()));
+			params.push_back(makeParam(offset(pIDSrc, 1), 0.f, makeRange::stepped(0.f, maxModDestF), valToStr::modDest(), strToVal::modDest()));
+			params.push_back(makeParam(offset(pIDSrc, 2), 0.f, makeRange::lin(-1.f, 1.f)));
+		}
 		// LOW LEVEL PARAMS END
 
 		for (auto param : params)
@@ -1614,8 +1849,7 @@ namespace param
 
 	void Params::loadPatch(const State& state)
 	{
-		const String idStr("params/");
-		const auto mda = state.get(idStr + "mdabs");
+		const auto mda = state.get(pathModDepthAbsolute);
 		if (mda != nullptr)
 			setModDepthAbsolute(static_cast<int>(*mda) != 0);
 
@@ -1628,8 +1862,54 @@ namespace param
 		for (auto param : params)
 			param->savePatch(state);
 
-		const String idStr("params/");
-		state.set(idStr + "mdabs", (isModDepthAbsolute() ? 1 : 0));
+		state.set(pathModDepthAbsolute, (isModDepthAbsolute() ? 1 : 0));
+	}
+
+	size_t Params::numFloats() const noexcept
+	{
+		return 1 + params.size() * NumFloatsPerParam;
+	}
+
+	void Params::savePatch(float* dest) const
+	{
+		dest[0] = isModDepthAbsolute() ? 1.f : 0.f;
+		++dest;
+		for (auto param : params)
+		{
+			param->savePatch(dest);
+			dest += NumFloatsPerParam;
+		}
+	}
+
+	void Params::loadPatch(const float* src)
+	{
+		setModDepthAbsolute(src[0] != 0.f);
+		++src;
+		for (auto param : params)
+		{
+			param->loadPatch(src);
+			src += NumFloatsPerParam;
+		}
+	}
+
+	void Params::loadPatch(const float* src, const juce::StringArray& ids)
+	{
+		setModDepthAbsolute(src[0] != 0.f);
+		++src;
+		for (auto i = 0; i < ids.size(); ++i)
+		{
+			const auto idx = getParamIdx(ids[i]);
+			if (idx != -1)
+				params[idx]->loadPatch(&src[i * NumFloatsPerParam]);
+		}
+	}
+
+	String Params::getLayout() const
+	{
+		juce::StringArray ids;
+		for (auto param : params)
+			ids.add(toID(toString(param->id)));
+		return ids.joinIntoString(",");
 	}
 
 	int Params::getParamIdx(const String& nameOrID) const
@@ -1650,12 +1930,35 @@ namespace param
 
 	void Params::modulate(float modSrc) noexcept
 	{
+		const auto macroChanged = modSrcLast != modSrc;
+		modSrcLast = modSrc;
+		auto changed = macroChanged;
 		for (auto i = 1; i < NumParams; ++i)
 		{
-			params[i]->startModulation();
-			params[i]->modulate(modSrc);
-			params[i]->endModulation();
+			auto& param = *params[i];
+			const auto dirty = param.consumeModDirty();
+			if (!dirty && !macroChanged)
+				continue;
+			const auto valModLast = param.getValMod();
+			param.startModulation();
+			param.modulate(modSrc);
+			param.endModulation();
+			changed = changed || param.getValMod() != valModLast;
 		}
+		if (!changed)
+			return;
+		++modEpoch;
+		snapshot.update(params);
+	}
+
+	uint32_t Params::getModulationEpoch() const noexcept
+	{
+		return modEpoch;
+	}
+
+	const ParamSnapshot& Params::getSnapshot() const noexcept
+	{
+		return snapshot;
 	}
 
 	Param* Params::operator[](int i) noexcept { return params[i]; }
@@ -5,6 +5,7 @@
 
 #include "../audio/dsp/hnm/modal/Axiom.h"
 #include "../audio/dsp/hnm/formant/FormantAxiom.h"
+#include "../audio/dsp/hnm/comb/CombAxiom.h"
 
 namespace param
 {
@@ -122,6 +123,37 @@ namespace param
 		Damp,
 		DampEnv,
 		DampWidth,
+		// hosts address parameters by index, so new ones go below this line:
+		// comb chord:
+		CombChord,
+		CombChordDepth,
+		// polyphony governor:
+		PolyGovernor,
+		// mod matrix, source, destination and depth of each slot:
+		ModSlot1Src,
+		ModSlot1Dest,
+		ModSlot1Depth,
+		ModSlot2Src,
+		ModSlot2Dest,
+		ModSlot2Depth,
+		ModSlot3Src,
+		ModSlot3Dest,
+		ModSlot3Depth,
+		ModSlot4Src,
+		ModSlot4Dest,
+		ModSlot4Depth,
+		ModSlot5Src,
+		ModSlot5Dest,
+		ModSlot5Depth,
+		ModSlot6Src,
+		ModSlot6Dest,
+		ModSlot6Depth,
+		ModSlot7Src,
+		ModSlot7Dest,
+		ModSlot7Depth,
+		ModSlot8Src,
+		ModSlot8Dest,
+		ModSlot8Depth,
 		//
 		NumParams
 	};
@@ -129,6 +161,24 @@ namespace param
 	static constexpr int MinLowLevelIdx = static_cast<int>(PID::Power) + 1;
 	static constexpr int NumLowLevelParams = NumParams - MinLowLevelIdx;
 
+	static constexpr int NumModSlots = 8;
+	static constexpr int NumParamsPerModSlot = 3;
+
+	// the parameters every voice keeps its own copy of, the mod matrix routes to them
+	static constexpr PID ModDests[] =
+	{
+		PID::ModalBlend, PID::ModalBlendEnv, PID::ModalBlendBreite,
+		PID::ModalSpreizung, PID::ModalSpreizungEnv, PID::ModalSpreizungBreite,
+		PID::ModalHarmonie, PID::ModalHarmonieEnv, PID::ModalHarmonieBreite,
+		PID::ModalKraft, PID::ModalKraftEnv, PID::ModalKraftBreite,
+		PID::ModalResonanz, PID::ModalResonanzEnv, PID::ModalResonanzBreite,
+		PID::FormantPos, PID::FormantPosEnv, PID::FormantPosWidth,
+		PID::FormantQ, PID::FormantQEnv, PID::FormantQWidth,
+		PID::CombUnison, PID::CombFeedback, PID::CombFeedbackEnv, PID::CombFeedbackWidth, PID::CombChordDepth,
+		PID::Damp, PID::DampEnv, PID::DampWidth
+	};
+	static constexpr int NumModDests = static_cast<int>(std::size(ModDests));
+
 	/* pID, offset */
 	PID ll(PID, int) noexcept;
 
@@ -173,6 +223,7 @@ namespace param
 		Custom,
 		FilterType,
 		Vowel,
+		Chord,
 		NumUnits
 	};
 
@@ -211,6 +262,12 @@ namespace param
 
 		void loadPatch(const State&);
 
+		// dest: value, mod depth, mod bias
+		void savePatch(float*) const;
+
+		// src: value, mod depth, mod bias
+		void loadPatch(const float*);
+
 		//called by host, normalized, thread-safe
 		float getValue() const override;
 
@@ -257,6 +314,9 @@ namespace param
 
 		void endModulation() noexcept;
 
+		// true if value, depth or bias changed since the last call
+		bool consumeModDirty() noexcept;
+
 		float getDefaultValue() const override;
 
 		String getName(int) const override;
@@ -296,9 +356,41 @@ namespace param
 		StrToValFunc strToVal;
 		Unit unit;
 
-		std::atomic<bool> locked, inGesture;
+		std::atomic<bool> locked, inGesture, modDirty;
 
 		bool modDepthAbsolute;
+		arch::StatePath pathValue, pathModDepth, pathModBias;
+	};
+
+	// denormalized, modulated values of all parameters, published once per host block.
+	// only the audio thread touches it, so reading it costs no atomics.
+	// each field counts its changes, so that stages can skip work when nothing changed.
+	class ParamSnapshot
+	{
+		using Parameters = std::vector<Param*>;
+	public:
+		using Version = uint32_t;
+
+		ParamSnapshot();
+
+		// params
+		void update(const Parameters&) noexcept;
+
+		// pID, returns denormalized value
+		float operator()(PID) const noexcept;
+
+		// pID, returns normalized value
+		float getNorm(PID) const noexcept;
+
+		// pID
+		Version getVersion(PID) const noexcept;
+
+		// pIDs
+		Version getVersion(std::initializer_list<PID>) const noexcept;
+	private:
+		alignas(64) std::array<float, NumParams> valsNorm;
+		alignas(64) std::array<float, NumParams> valsDenorm;
+		alignas(64) std::array<Version, NumParams> versions;
 	};
 
 	class Params
@@ -316,12 +408,36 @@ namespace param
 
 		void savePatch(State&) const;
 
+		// floats of each parameter in the binary state
+		static constexpr int NumFloatsPerParam = 3;
+
+		// mod depth absolute, then NumFloatsPerParam per parameter
+		size_t numFloats() const noexcept;
+
+		// dest, packed in PID order
+		void savePatch(float*) const;
+
+		// src, packed in PID order
+		void loadPatch(const float*);
+
+		// src, ids; for states saved by a version with different parameters
+		void loadPatch(const float*, const juce::StringArray&);
+
+		// ids of all parameters in PID order, comma separated
+		String getLayout() const;
+
 		int getParamIdx(const String& /*nameOrID*/) const;
 
 		size_t numParams() const noexcept;
 
+		// only recomputes parameters whose value, depth or bias changed, unless the macro moved
 		void modulate(float modSrc) noexcept;
 
+		// increments whenever modulate changed any value
+		uint32_t getModulationEpoch() const noexcept;
+
+		const ParamSnapshot& getSnapshot() const noexcept;
+
 		bool isModDepthAbsolute() const noexcept;
 		void setModDepthAbsolute(bool) noexcept;
 		void switchModDepthAbsolute() noexcept;
@@ -340,6 +456,10 @@ namespace param
 		const Parameters& data() const noexcept;
 	protected:
 		Parameters params;
+		ParamSnapshot snapshot;
 		std::atomic<float> modDepthAbsolute;
+		float modSrcLast;
+		uint32_t modEpoch;
+		arch::StatePath pathModDepthAbsolute;
 	};
 }
\ No newline at end of file